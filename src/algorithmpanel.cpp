@@ -103,7 +103,26 @@ void AlgorithmPanel::buildUI()
         { "bfs", "Breadth-first traversal from a source node" },
         { "dfs", "Depth-first traversal from a source node" },
         { "dijkstra", "Shortest paths — uses edge labels as weights" },
+        { "astar", "Shortest s–t path guided by node positions" },
+        { "alt_build", "Precompute landmark distances for fast s–t queries" },
+        { "alt", "Shortest s–t path using landmark lower bounds" },
+        { "ch_build", "Rebuild the contraction hierarchy and report its stats" },
+        { "ch", "Shortest s–t path on the contraction hierarchy" },
         { "components", "Count and list all connected components" },
+        { "scc", "Strongly connected components and their condensation DAG" },
+        { "diameter", "Exact diameter, radius, centre and periphery in a few BFS runs" },
+        { "hyperanf", "Approximate distance distribution (HyperANF) for large graphs" },
+        { "communities", "Louvain communities as a node column" },
+        { "label_propagation", "Fast label propagation clustering for very large graphs" },
+        { "hop_stats", "All-pairs hop distances, closeness and diameter" },
+        { "betweenness", "Betweenness centrality, exact or sampled, as a node column" },
+        { "pagerank", "PageRank with damping and optional personalisation" },
+        { "eigenvector", "Eigenvector centrality by power iteration" },
+        { "triangles", "Triangle counts and clustering coefficients" },
+        { "kcore", "Core number of every node (k-core decomposition)" },
+        { "articulation", "Cut vertices, bridges and biconnected blocks" },
+        { "mst", "Minimum spanning forest, optionally shown as the only edges" },
+        { "maxflow", "Maximum s-t flow and minimum cut, capacities from edge labels" },
     };
 
     const QList<QPair<QString,QString>> visualAlgos = {
@@ -111,7 +130,11 @@ void AlgorithmPanel::buildUI()
         { "circular", "Arrange nodes evenly around a circle" },
         { "spiral", "Arrange nodes along a spiral" },
         { "contract_components", "Contract components into nodes"},
-        { "contract_high_degree", "Contract high degree nodes"}
+        { "contract_high_degree", "Contract high degree nodes"},
+        { "contract_kcore", "Contract everything outside the k-core"},
+        { "contract_scc", "Contract each strongly connected component"},
+        { "contract_communities", "Contract each community from the last clustering"},
+        { "contract_grid", "Merge nodes that share a screen grid cell at the current zoom"}
     };
 
     m_stack->addWidget(buildAlgoPage(searchAlgos));   
@@ -169,12 +192,35 @@ QWidget* AlgorithmPanel::buildAlgoPage(const QList<QPair<QString,QString>>& algo
         { "bfs", "BFS"},
         { "dfs", "DFS"},
         { "dijkstra", "Dijkstra"},
+        { "astar", "A* Search"},
+        { "alt_build", "Build Landmarks"},
+        { "alt", "ALT Query"},
+        { "ch_build", "Rebuild CH"},
+        { "ch", "CH Query"},
         { "components", "Components"},
+        { "scc", "Strong Components"},
+        { "hop_stats", "Hop Distances"},
+        { "betweenness", "Betweenness"},
+        { "pagerank", "PageRank"},
+        { "eigenvector", "Eigenvector"},
+        { "triangles", "Triangles"},
+        { "kcore", "k-Core"},
+        { "articulation", "Cut Vertices & Bridges"},
+        { "mst", "Spanning Forest"},
+        { "maxflow", "Max Flow / Min Cut"},
+        { "diameter", "Diameter & Radius"},
+        { "hyperanf", "Distance Distribution"},
+        { "communities", "Communities"},
+        { "label_propagation", "Label Propagation"},
         { "sfdp", "SFDP Layout"},
         { "circular", "Circular Layout"},
         { "spiral", "Spiral Layout"},
         { "contract_components", "Contract Components"},
-        { "contract_high_degree", "Contract High-Degrees"}
+        { "contract_high_degree", "Contract High-Degrees"},
+        { "contract_kcore", "Contract Outside k-Core"},
+        { "contract_scc", "Contract SCCs"},
+        { "contract_communities", "Contract Communities"},
+        { "contract_grid", "Contract By Proximity"}
     };
 
     // scrollable area
@@ -456,17 +502,19 @@ bool AlgorithmPanel::askSFDPParams(SFDPParams& out) {
     return true;
 }
 
-// format the elapsed time
-QString formatTimer(QElapsedTimer& timer) {
-    // stop timer
-    qint64 elapsedUs = timer.nsecsElapsed() / 1000;
-    QString timeStr = elapsedUs < 1000
+// format a duration in nanoseconds as µs / ms / s
+QString formatNsecs(qint64 nsecs) {
+    qint64 elapsedUs = nsecs / 1000;
+    return elapsedUs < 1000
         ? QString("%1 µs").arg(elapsedUs)
         : elapsedUs < 1000000
             ? QString("%1 ms").arg(elapsedUs / 1000.0, 0, 'f', 2)
             : QString("%1 s").arg(elapsedUs / 1000000.0, 0, 'f', 3);
+}
 
-    return QString("\nTime: %1").arg(timeStr);
+// format the elapsed time
+QString formatTimer(QElapsedTimer& timer) {
+    return QString("\nTime: %1").arg(formatNsecs(timer.nsecsElapsed()));
 }
 
 // ---------------------------------------------------------------
@@ -502,6 +550,33 @@ void AlgorithmPanel::runAlgorithm(const QString& id)
             result = algoDijkstra(p.sourceId, p.targetId); 
         }
     }
+    else if (id == "astar") {
+        AStarParams ap;
+        if (!askParams("A*", true, true, p)) return;
+        if (!askAStarParams(ap)) return;
+        title = "A* Search";
+        result = algoAStar(p.sourceId, p.targetId, ap);
+    }
+    else if (id == "alt_build") {
+        AltParams lp;
+        if (!askAltParams(lp)) return;
+        title = "Build Landmarks";
+        result = algoBuildAlt(lp);
+    }
+    else if (id == "alt") {
+        if (!askParams("ALT", true, true, p)) return;
+        title = "ALT Query";
+        result = algoAlt(p.sourceId, p.targetId);
+    }
+    else if (id == "ch_build") {
+        title = "Rebuild CH";
+        result = algoBuildCh();
+    }
+    else if (id == "ch") {
+        if (!askParams("CH", true, true, p)) return;
+        title = "CH Query";
+        result = algoCh(p.sourceId, p.targetId);
+    }
     else if (id == "sfdp") {
         SFDPParams sp;
         if (!askSFDPParams(sp)) return;
@@ -515,7 +590,64 @@ void AlgorithmPanel::runAlgorithm(const QString& id)
         title = "Spiral Layout";
         result = algoSpiralLayout();
     }
-    else if (id == "components") { title = "Connected Components"; result = algoConnectedComponents(); }
+    else if (id == "components") {
+        // following out-edges only is not a component on a directed graph
+        if (m_netSimWindow->directedEdges) { title = "Strongly Connected Components"; result = algoStronglyConnected(); }
+        else { title = "Connected Components"; result = algoConnectedComponents(); }
+    }
+    else if (id == "scc") { title = "Strongly Connected Components"; result = algoStronglyConnected(); }
+    else if (id == "hop_stats") { title = "Hop Distances"; result = algoHopDistances(); }
+    else if (id == "betweenness") {
+        BetweennessParams bp;
+        if (!askBetweennessParams(bp)) return;
+        title = "Betweenness Centrality";
+        result = algoBetweenness(bp);
+    }
+    else if (id == "pagerank") {
+        PageRankParams pp;
+        if (!askPageRankParams(pp, false)) return;
+        title = "PageRank";
+        result = algoPageRank(pp);
+    }
+    else if (id == "eigenvector") {
+        PageRankParams pp;
+        if (!askPageRankParams(pp, true)) return;
+        title = "Eigenvector Centrality";
+        result = algoEigenvector(pp);
+    }
+    else if (id == "triangles") { title = "Triangles / Clustering"; result = algoTriangles(); }
+    else if (id == "kcore") { title = "k-Core Decomposition"; result = algoKCore(); }
+    else if (id == "articulation") { title = "Cut Vertices & Bridges"; result = algoArticulation(); }
+    else if (id == "diameter") { title = "Diameter & Radius"; result = algoDiameter(); }
+    else if (id == "communities") {
+        LouvainParams lp;
+        if (!askLouvainParams(lp)) return;
+        title = "Communities (Louvain)";
+        result = algoCommunities(lp);
+    }
+    else if (id == "label_propagation") {
+        LabelPropagationParams lp;
+        if (!askLabelPropagationParams(lp)) return;
+        title = "Communities (Label Propagation)";
+        result = algoLabelPropagation(lp);
+    }
+    else if (id == "hyperanf") {
+        HyperAnfParams hp;
+        if (!askHyperAnfParams(hp)) return;
+        title = "Distance Distribution (HyperANF)";
+        result = algoHyperAnf(hp);
+    }
+    else if (id == "maxflow") {
+        if (!askParams("Max Flow", true, true, p)) return;
+        title = "Max Flow / Min Cut";
+        result = algoMaxFlow(p.sourceId, p.targetId);
+    }
+    else if (id == "mst") {
+        MstParams mp;
+        if (!askMstParams(mp)) return;
+        title = "Minimum Spanning Forest";
+        result = algoSpanningForest(mp);
+    }
     else if (id == "contract_components") {
         title = "Contract Components";
         result = runCompContract();
@@ -524,6 +656,22 @@ void AlgorithmPanel::runAlgorithm(const QString& id)
         title = "Contract High-Degree Nodes";
         result = algoContractHighDegree();
     }
+    else if (id == "contract_kcore") {
+        title = "Contract Outside k-Core";
+        result = algoContractOutsideKCore();
+    }
+    else if (id == "contract_scc") {
+        title = "Contract SCCs";
+        result = algoContractScc();
+    }
+    else if (id == "contract_communities") {
+        title = "Contract Communities";
+        result = algoContractCommunities();
+    }
+    else if (id == "contract_grid") {
+        title = "Contract By Proximity";
+        result = algoContractGrid();
+    }
     else {
         title = "Error";
         result = QString("Unknown algorithm: %1").arg(id);
@@ -1288,71 +1436,10 @@ bool AlgorithmPanel::askContractHighDegreeParams(ContractHighDegreeParams& out)
     return true;
 }
 
-// contract high degree nodes algorithm
-QString AlgorithmPanel::algoContractHighDegree(bool askUser)
+// split a set of backend nodes into the connected groups it induces
+QVector<QVector<int>> AlgorithmPanel::connectedGroups(const QSet<int>& toContractSet) const
 {
-    if (!m_dataHandler || m_dataHandler->nodeCount() == 0)
-        return "No nodes in graph.";
-
-    ContractHighDegreeParams params;
-    if (askUser) {
-        if (!askContractHighDegreeParams(params)) return "Cancelled.";
-    } else {
-        params = m_contractHighDegreeParams;
-    }
-
-    // Collect degrees
-    const int N = m_dataHandler->nodeCount();
-    QVector<QPair<int,double>> degreeList;
-    degreeList.reserve(N);
-    for (int i = 0; i < N; ++i) {
-        if (!m_dataHandler->nodeExists(i)) continue;
-        degreeList.append({i, (double)m_dataHandler->getNode(i)->degree});
-    }
-    if (degreeList.isEmpty()) return "No nodes with valid degrees.";
-
-    // Sort by degree descending
-    std::sort(degreeList.begin(), degreeList.end(),
-              [](const QPair<int,double>& a, const QPair<int,double>& b){
-                  return a.second > b.second;
-              });
-
-    // qCeil ensures we always pick at least one node even at tiny percents.
-    const int topCount = qMax(1, qCeil(degreeList.size() * params.percent / 100.0));
-    QSet<int> seedSet;
-    for (int i = 0; i < topCount; ++i)
-        seedSet.insert(degreeList[i].first);
-
-    // BFS 
-    QSet<int> toContractSet;
-    {
-        QQueue<QPair<int,int>> bfsQ;
-        for (int seed : seedSet) {
-            toContractSet.insert(seed);
-            bfsQ.enqueue({seed, 0});
-        }
-        QSet<int> bfsVisited;
-        while (!bfsQ.isEmpty()) {
-            auto [cur, dist] = bfsQ.dequeue();
-            if (bfsVisited.contains(cur)) continue;
-            bfsVisited.insert(cur);
-
-            // Stop expanding beyond the requested hop radius
-            if (dist >= params.hops) continue;
-            for (const EdgeInfo& e : m_dataHandler->getEdgesOf(cur)) {
-                int nb = e.destination;
-                if (!toContractSet.contains(nb)) {
-                    toContractSet.insert(nb);
-                    bfsQ.enqueue({nb, dist + 1});
-                }
-            }
-        }
-    }
-
-    if (toContractSet.size() < 2)
-        return "Less than 2 nodes selected – nothing to contract.";
-
-    // Find connected components within toContractSet 
+    // BFS restricted to the set from every unvisited member
     QMap<int,int> compOf;
     QVector<QVector<int>> compMembers;
     for (int nodeId : toContractSet) {
@@ -1379,6 +1466,18 @@ QString AlgorithmPanel::algoContractHighDegree(bool askUser)
         }
         compMembers.append(members);
     }
+    return compMembers;
+}
+
+// replace the visible graph with one node per group (plain node for single
+// member groups) plus every backend node in no group, then rebuild the edges
+// between them with parallel edges aggregated into contracted edges
+void AlgorithmPanel::applyContraction(const QVector<QVector<int>>& compMembers)
+{
+    QSet<int> toContractSet;
+    for (const QVector<int>& members : compMembers)
+        for (int backId : members)
+            toContractSet.insert(backId);
 
     // Snapshot visual positions before any deletion
     QHash<int, QPointF> backIdToPos;
@@ -1469,55 +1568,28 @@ QString AlgorithmPanel::algoContractHighDegree(bool askUser)
     const bool directed   = m_netSimWindow->directedEdges;
     const bool showLabels = m_netSimWindow->showEdgeLabels;
 
-    QHash<QPair<int,int>, int> edgeCountMap; 
-    QHash<QPair<int,int>, QString> edgeLabelMap; 
-    QSet<QPair<int,int>> visitedBack;   
-
-    for (int backSrc = 0; backSrc < allNodesVec->size(); ++backSrc) {
-        if (!m_dataHandler->nodeExists(backSrc)) continue;
-        for (const EdgeInfo& e : m_dataHandler->getEdgesOf(backSrc)) {
-            int backDst = e.destination;
-            if (!m_dataHandler->nodeExists(backDst)) continue;
-
-            // get a normalized key
-            QPair<int,int> backKey = directed
-                ? qMakePair(backSrc, backDst)
-                : qMakePair(qMin(backSrc, backDst), qMax(backSrc, backDst));
-            if (visitedBack.contains(backKey)) continue;
-            visitedBack.insert(backKey);
-
-            // Resolve each backend id to its front id
-            int fSrc = m_netSimWindow->backIdToFrontId(backSrc);
-            int fDst = m_netSimWindow->backIdToFrontId(backDst);
-
-            if (fSrc == fDst) continue;
-            if (!m_nodeItems->contains(fSrc) || !m_nodeItems->contains(fDst)) continue;
-
-            // get a normalized key for the frontend pair
-            QPair<int,int> frontKey = directed
-                ? qMakePair(fSrc, fDst)
-                : qMakePair(qMin(fSrc, fDst), qMax(fSrc, fDst));
-
-            edgeCountMap[frontKey]++;
-
-            // Record the first encountered label as a fallback for normal edges.
-            if (!edgeLabelMap.contains(frontKey))
-                edgeLabelMap[frontKey] = e.label;
-        }
+    // front id per backend id, then one sort groups the crossing edges by front pair
+    QVector<int> frontOf(allNodesVec->size(), NO_FRONT);
+    for (int i = 0; i < allNodesVec->size(); ++i) {
+        if (!m_dataHandler->nodeExists(i)) continue;
+        const int f = m_netSimWindow->backIdToFrontId(i);
+        if (m_nodeItems->contains(f)) frontOf[i] = f;
     }
+    const QVector<QuotientEdge> quotientEdges = aggregateQuotientEdges(*m_dataHandler, frontOf, directed);
+    const QVector<EdgeInfo>* allEdgesVec = m_dataHandler->getAllEdges();
 
     // Create one visual edge per unique frontend pair.
     const int totalFrontNodes = m_nodeItems->size();
-    for (auto it = edgeCountMap.cbegin(); it != edgeCountMap.cend(); ++it) {
-        const int fSrc  = it.key().first;
-        const int fDst  = it.key().second;
-        const int count = it.value();
+    for (const QuotientEdge& q : quotientEdges) {
+        const int fSrc  = q.src;
+        const int fDst  = q.dst;
+        const int count = q.count;
 
         // make contracted edge label
         const bool isContracted = (fSrc < 0 || fDst < 0 || count > 1);
         const QString edgeLabel = isContracted
             ? QString("x%1").arg(count)
-            : edgeLabelMap.value(it.key());
+            : allEdgesVec->at(q.arc).label;
 
         // AddVisualEdge handles inserting into m_edgeItems and graphPanel.
         m_netSimWindow->AddVisualEdge(fSrc, fDst, edgeLabel, directed);
@@ -1539,6 +1611,74 @@ QString AlgorithmPanel::algoContractHighDegree(bool askUser)
     m_netSimWindow->updateSceneRect();
     m_netSimWindow->graphPanel->refresh();
     m_netSimWindow->resetView();
+}
+
+// contract high degree nodes algorithm
+QString AlgorithmPanel::algoContractHighDegree(bool askUser)
+{
+    if (!m_dataHandler || m_dataHandler->nodeCount() == 0)
+        return "No nodes in graph.";
+
+    ContractHighDegreeParams params;
+    if (askUser) {
+        if (!askContractHighDegreeParams(params)) return "Cancelled.";
+    } else {
+        params = m_contractHighDegreeParams;
+    }
+
+    // Collect degrees
+    const int N = m_dataHandler->nodeCount();
+    QVector<QPair<int,double>> degreeList;
+    degreeList.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        if (!m_dataHandler->nodeExists(i)) continue;
+        degreeList.append({i, (double)m_dataHandler->getNode(i)->degree});
+    }
+    if (degreeList.isEmpty()) return "No nodes with valid degrees.";
+
+    // Sort by degree descending
+    std::sort(degreeList.begin(), degreeList.end(),
+              [](const QPair<int,double>& a, const QPair<int,double>& b){
+                  return a.second > b.second;
+              });
+
+    // qCeil ensures we always pick at least one node even at tiny percents.
+    const int topCount = qMax(1, qCeil(degreeList.size() * params.percent / 100.0));
+    QSet<int> seedSet;
+    for (int i = 0; i < topCount; ++i)
+        seedSet.insert(degreeList[i].first);
+
+    // BFS 
+    QSet<int> toContractSet;
+    {
+        QQueue<QPair<int,int>> bfsQ;
+        for (int seed : seedSet) {
+            toContractSet.insert(seed);
+            bfsQ.enqueue({seed, 0});
+        }
+        QSet<int> bfsVisited;
+        while (!bfsQ.isEmpty()) {
+            auto [cur, dist] = bfsQ.dequeue();
+            if (bfsVisited.contains(cur)) continue;
+            bfsVisited.insert(cur);
+
+            // Stop expanding beyond the requested hop radius
+            if (dist >= params.hops) continue;
+            for (const EdgeInfo& e : m_dataHandler->getEdgesOf(cur)) {
+                int nb = e.destination;
+                if (!toContractSet.contains(nb)) {
+                    toContractSet.insert(nb);
+                    bfsQ.enqueue({nb, dist + 1});
+                }
+            }
+        }
+    }
+
+    if (toContractSet.size() < 2)
+        return "Less than 2 nodes selected – nothing to contract.";
+
+    const QVector<QVector<int>> compMembers = connectedGroups(toContractSet);
+    applyContraction(compMembers);
 
     return QString("Contracted %1 node(s) into %2 group(s).\n"
                    "Top %3% high-degree seeds, radius %4 hop(s).")
@@ -1549,94 +1689,334 @@ QString AlgorithmPanel::algoContractHighDegree(bool askUser)
 }
 
 
-// ---------------------------------------------------------------
-// Search Algorithms
-// ---------------------------------------------------------------
+// ask for k, the spin box is capped at the degeneracy so the core is never empty
+bool AlgorithmPanel::askKCoreContractParams(KCoreContractParams& out, int degeneracy) {
+    out = m_kCoreContractParams;
 
-// return either the source node if valid, or the first node in the graph (if any) as a fallback
-int AlgorithmPanel::sourceOrFirst() const {
-    if (m_sourceId != -1 && m_dataHandler->nodeExists(m_sourceId)) return m_sourceId;
-    return m_dataHandler->nodeCount() > 0 ? 0 : -1;
-}
+    QDialog dlg(this);
+    dlg.setWindowTitle("Contract Outside k-Core Parameters");
+    dlg.setMinimumWidth(320);
 
-// ---------------------------------------------------------------
-// BFS
-// ---------------------------------------------------------------
-QString AlgorithmPanel::algoBFS(int sourceId, int targetId) {
-    // get source and target nodes
-    if (!m_dataHandler->nodeExists(sourceId)) return "No source node.";
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
 
-    // make the visited and prev maps, and the queue for BFS
-    QMap<int, bool> visited;
-    QMap<int, int> prev;
-    QQueue<int> queue;
-    QStringList order;
-    bool foundTarget = false;
+    auto* descLbl = new QLabel(QString(
+        "Keeps the k-core (every node with core number >= k) as it is and\n"
+        "contracts each connected group of the remaining nodes into one node.\n"
+        "Largest k with a non-empty core: %1.").arg(degeneracy));
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
 
-    visited[sourceId] = true;
-    prev[sourceId] = -1;
-    queue.enqueue(sourceId);
+    auto* kSpin = new QSpinBox;
+    kSpin->setRange(1, qMax(1, degeneracy));
+    kSpin->setValue(qMin(out.k, qMax(1, degeneracy)));
+    form->addRow("k:", kSpin);
 
-    // start timer
-    QElapsedTimer timer;
-    timer.start();
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
 
-    // standard BFS loop
-    while (!queue.isEmpty()) {
-        const int curId = queue.dequeue();
+    if (dlg.exec() != QDialog::Accepted) return false;
 
-        // add the current node to the visit order and check if it's the target
-        order << m_dataHandler->nodeLabel(curId);
-        if (targetId != -1 && curId == targetId) { foundTarget = true; break; }
+    out.k = kSpin->value();
+    m_kCoreContractParams = out;
+    return true;
+}
 
-        // enqueue unvisited neighbours
-        const QVector<EdgeInfo> edges = m_dataHandler->getEdgesOf(curId);
-        for (const EdgeInfo& e : edges) {
-            if (!visited.contains(e.destination)) {
-                visited[e.destination] = true;
-                prev[e.destination]    = curId;
-                queue.enqueue(e.destination);
-            }
-        }
-    }
+// contract every node whose core number is below k
+QString AlgorithmPanel::algoContractOutsideKCore(bool askUser)
+{
+    if (!m_dataHandler || m_dataHandler->nodeCount() == 0)
+        return "No nodes in graph.";
 
-    // format results
-    QStringList lines;
-    lines << formatTimer(timer);
-    lines << QString("Source     : %1").arg(m_dataHandler->nodeLabel(sourceId));
-    lines << QString("Visited    : %1 / %2").arg(visited.size()).arg(m_dataHandler->nodeCount());
-    int unreached = m_dataHandler->nodeCount() - visited.size();
-    if (unreached > 0)
-        lines << QString("Unreached  : %1 node(s)").arg(unreached);
+    const QVector<int> core = coreNumbers(CsrGraph::fromDataHandler(*m_dataHandler));
+    const int degeneracy = core.isEmpty() ? 0 : *std::max_element(core.cbegin(), core.cend());
 
-    if (targetId != -1) {
-        lines << QString("Target     : %1").arg(m_dataHandler->nodeLabel(targetId));
-        if (foundTarget) {
-            QStringList path;
-            for (int cur = targetId; cur != -1; cur = prev.value(cur, -1))
-                path.prepend(m_dataHandler->nodeLabel(cur));
-            lines << QString("Found after: %1 step(s)").arg(path.size() - 1);
-            lines << QString("Path       : %1").arg(path.join(" -> "));
-        } else {
-            lines << "Target not reachable from source.";
-        }
-        lines << "";
+    KCoreContractParams params;
+    if (askUser) {
+        if (!askKCoreContractParams(params, degeneracy)) return "Cancelled.";
+    } else {
+        params = m_kCoreContractParams;
     }
-    lines << QString("Visit order: %1").arg(order.join(" -> "));
 
-    
-    return lines.join("\n");
+    QSet<int> toContractSet;
+    int kept = 0;
+    for (int v = 0; v < core.size(); ++v) {
+        if (core[v] < 0) continue;
+        if (core[v] < params.k) toContractSet.insert(v);
+        else ++kept;
+    }
+
+    if (toContractSet.size() < 2)
+        return QString("Less than 2 nodes outside the %1-core – nothing to contract.").arg(params.k);
+
+    const QVector<QVector<int>> compMembers = connectedGroups(toContractSet);
+    applyContraction(compMembers);
+
+    return QString("Contracted %1 node(s) outside the %2-core into %3 group(s).\n"
+                   "%4 node(s) kept in the core.")
+               .arg(toContractSet.size())
+               .arg(params.k)
+               .arg(compMembers.size())
+               .arg(kept);
 }
 
-// ---------------------------------------------------------------
-// DFS
-// ---------------------------------------------------------------
-QString AlgorithmPanel::algoDFS(int sourceId, int targetId)
+// contract every strongly connected component with more than one node
+QString AlgorithmPanel::algoContractScc()
 {
-    if (sourceId == -1 || !m_dataHandler->nodeExists(sourceId)) return "No source node.";
+    if (!m_dataHandler || m_dataHandler->nodeCount() == 0)
+        return "No nodes in graph.";
 
-    QSet<int> visited;
-    QMap<int, int> prev;
+    const SccResult scc = stronglyConnectedComponents(CsrGraph::fromDataHandler(*m_dataHandler));
+
+    QVector<QVector<int>> groups(scc.count);
+    for (int v = 0; v < scc.component.size(); ++v)
+        if (scc.component[v] != -1 && scc.sizes[scc.component[v]] > 1)
+            groups[scc.component[v]].append(v);
+
+    QVector<QVector<int>> compMembers;
+    int contracted = 0;
+    for (const QVector<int>& members : groups) {
+        if (members.isEmpty()) continue;
+        compMembers.append(members);
+        contracted += members.size();
+    }
+
+    if (compMembers.isEmpty())
+        return "Every strongly connected component is a single node – nothing to contract.";
+
+    applyContraction(compMembers);
+
+    return QString("Contracted %1 node(s) into %2 strongly connected component(s).%3")
+               .arg(contracted)
+               .arg(compMembers.size())
+               .arg(m_netSimWindow->directedEdges ? "" : "\nEdges are undirected, so these are the connected components.");
+}
+
+// merge the nodes that land in the same grid cell, the cell is a fixed number of
+// screen pixels so zooming out gives coarser groups. one pass over the positions
+QString AlgorithmPanel::algoContractGrid(bool askUser)
+{
+    if (!m_dataHandler || m_dataHandler->nodeCount() == 0)
+        return "No nodes in graph.";
+
+    GridContractParams params;
+    if (askUser) {
+        if (!askGridContractParams(params)) return "Cancelled.";
+    } else {
+        params = m_gridContractParams;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const qreal zoom = m_netSimWindow->viewZoom();
+    const double cell = params.cellPixels / qMax<qreal>(zoom, 1e-6);
+
+    QVector<bool> hasPos;
+    const QVector<QPointF> pos = backendPositions(hasPos);
+    for (int v = 0; v < pos.size(); ++v)
+        if (hasPos[v] && !m_dataHandler->nodeExists(v)) hasPos[v] = false;
+
+    const GridCells grid = gridCells(pos, hasPos, cell);
+    QVector<QVector<int>> cells(grid.count());
+    for (int c = 0; c < grid.count(); ++c) cells[c].reserve(grid.sizes[c]);
+    for (int v = 0; v < pos.size(); ++v)
+        if (grid.cellOf[v] >= 0) cells[grid.cellOf[v]].append(v);
+
+    QVector<QVector<int>> compMembers;
+    int merged = 0;
+    for (QVector<int>& members : cells) {
+        if (members.size() < 2) continue;
+        merged += members.size();
+        compMembers.append(std::move(members));
+    }
+    const qint64 bucketNs = timer.nsecsElapsed();
+
+    if (compMembers.isEmpty())
+        return QString("No two nodes share a %1 px cell at this zoom – nothing to contract.")
+                   .arg(params.cellPixels, 0, 'f', 0);
+
+    applyContraction(compMembers);
+
+    QStringList lines;
+    lines << QString("\nTime: %1 (grid pass %2)")
+                 .arg(formatNsecs(timer.nsecsElapsed()))
+                 .arg(formatNsecs(bucketNs));
+    lines << QString("Cell: %1 px at zoom %2 = %3 scene units")
+                 .arg(params.cellPixels, 0, 'f', 0)
+                 .arg(zoom, 0, 'f', 3)
+                 .arg(cell, 0, 'f', 1);
+    lines << QString("Occupied cells: %1").arg(grid.count());
+    lines << QString("Contracted %1 node(s) into %2 group(s).").arg(merged).arg(compMembers.size());
+    return lines.join("\n");
+}
+
+bool AlgorithmPanel::askGridContractParams(GridContractParams& out) {
+    out = m_gridContractParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Contract By Proximity Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(QString(
+        "Lays a grid over the scene and merges every node in a cell into one node,\n"
+        "edges between cells are aggregated. The cell is measured on screen,\n"
+        "so the current zoom (%1) decides how coarse the overview is.")
+        .arg(m_netSimWindow->viewZoom(), 0, 'f', 3));
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* cellSpin = new QDoubleSpinBox;
+    cellSpin->setRange(4.0, 2000.0);
+    cellSpin->setDecimals(0);
+    cellSpin->setSingleStep(10.0);
+    cellSpin->setSuffix(" px");
+    cellSpin->setValue(out.cellPixels);
+    form->addRow("Cell size:", cellSpin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.cellPixels = cellSpin->value();
+    m_gridContractParams = out;
+    return true;
+}
+
+// contract every Louvain community, reusing the last run while the graph is unchanged
+QString AlgorithmPanel::algoContractCommunities()
+{
+    if (!m_dataHandler || m_dataHandler->nodeCount() == 0)
+        return "No nodes in graph.";
+
+    // rerun whichever method produced the last grouping if the graph has changed since
+    const bool reused = m_communities.count > 0 && m_communitiesRevision == m_dataHandler->revision();
+    if (!reused) {
+        const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+        m_communities = m_communitiesFromLabels ? labelPropagation(g, m_labelPropagationParams.maxSweeps)
+                                                : louvainCommunities(g, m_louvainParams.resolution);
+        m_communitiesRevision = m_dataHandler->revision();
+    }
+
+    QVector<QVector<int>> compMembers(m_communities.count);
+    for (int v = 0; v < m_communities.community.size(); ++v)
+        if (m_communities.community[v] != -1) compMembers[m_communities.community[v]].append(v);
+
+    int contracted = 0;
+    for (const QVector<int>& members : compMembers)
+        if (members.size() > 1) ++contracted;
+    if (contracted == 0)
+        return "Every community is a single node – nothing to contract.";
+
+    applyContraction(compMembers);
+
+    return QString("Contracted %1 communit%2 (modularity %3)%4.")
+               .arg(contracted)
+               .arg(contracted == 1 ? "y" : "ies")
+               .arg(m_communities.modularity, 0, 'f', 4)
+               .arg(reused ? ", from the last community run" : "");
+}
+
+// ---------------------------------------------------------------
+// Search Algorithms
+// ---------------------------------------------------------------
+
+// return either the source node if valid, or the first node in the graph (if any) as a fallback
+int AlgorithmPanel::sourceOrFirst() const {
+    if (m_sourceId != -1 && m_dataHandler->nodeExists(m_sourceId)) return m_sourceId;
+    return m_dataHandler->nodeCount() > 0 ? 0 : -1;
+}
+
+// ---------------------------------------------------------------
+// BFS
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoBFS(int sourceId, int targetId) {
+    // get source and target nodes
+    if (!m_dataHandler->nodeExists(sourceId)) return "No source node.";
+
+    // make the visited and prev maps, and the queue for BFS
+    QMap<int, bool> visited;
+    QMap<int, int> prev;
+    QQueue<int> queue;
+    QStringList order;
+    bool foundTarget = false;
+
+    visited[sourceId] = true;
+    prev[sourceId] = -1;
+    queue.enqueue(sourceId);
+
+    // start timer
+    QElapsedTimer timer;
+    timer.start();
+
+    // standard BFS loop
+    while (!queue.isEmpty()) {
+        const int curId = queue.dequeue();
+
+        // add the current node to the visit order and check if it's the target
+        order << m_dataHandler->nodeLabel(curId);
+        if (targetId != -1 && curId == targetId) { foundTarget = true; break; }
+
+        // enqueue unvisited neighbours
+        const QVector<EdgeInfo> edges = m_dataHandler->getEdgesOf(curId);
+        for (const EdgeInfo& e : edges) {
+            if (!visited.contains(e.destination)) {
+                visited[e.destination] = true;
+                prev[e.destination]    = curId;
+                queue.enqueue(e.destination);
+            }
+        }
+    }
+
+    // format results
+    QStringList lines;
+    lines << formatTimer(timer);
+    lines << QString("Source     : %1").arg(m_dataHandler->nodeLabel(sourceId));
+    lines << QString("Visited    : %1 / %2").arg(visited.size()).arg(m_dataHandler->nodeCount());
+    int unreached = m_dataHandler->nodeCount() - visited.size();
+    if (unreached > 0)
+        lines << QString("Unreached  : %1 node(s)").arg(unreached);
+
+    if (targetId != -1) {
+        lines << QString("Target     : %1").arg(m_dataHandler->nodeLabel(targetId));
+        if (foundTarget) {
+            QStringList path;
+            for (int cur = targetId; cur != -1; cur = prev.value(cur, -1))
+                path.prepend(m_dataHandler->nodeLabel(cur));
+            lines << QString("Found after: %1 step(s)").arg(path.size() - 1);
+            lines << QString("Path       : %1").arg(path.join(" -> "));
+        } else {
+            lines << "Target not reachable from source.";
+        }
+        lines << "";
+    }
+    lines << QString("Visit order: %1").arg(order.join(" -> "));
+
+    
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// DFS
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoDFS(int sourceId, int targetId)
+{
+    if (sourceId == -1 || !m_dataHandler->nodeExists(sourceId)) return "No source node.";
+
+    QSet<int> visited;
+    QMap<int, int> prev;
     QStack<int> stack;
     QStringList order;
     bool foundTarget = false;
@@ -1711,72 +2091,47 @@ QString AlgorithmPanel::algoDijkstra(int sourceId, int targetId)
     QElapsedTimer timer;
     timer.start();
 
-    // validate all edge labels are numeric, non-numeric are treated as 1
-    bool allNumeric = true;
-    const QVector<EdgeInfo>* allEdges = m_dataHandler->getAllEdges();
-    for (const EdgeInfo& e : *allEdges) {
-        bool ok; e.label.toDouble(&ok);
-        if (!ok && !e.label.isEmpty()) { allNumeric = false; break; }
-    }
-
-    // initialize distances, previous nodes, and visited set
-    const double INF = std::numeric_limits<double>::infinity();
-    const QVector<NodeInfo>* allNodes = m_dataHandler->getAllNodes();
-    int N = allNodes->size();
-
-    QVector<double> dist(N, INF);
-    QVector<int> prev(N, -1);
-    QVector<bool> visited(N, false);
-
-    dist[sourceId] = 0.0;
-
-    // min-priority queue (distance, node)
-    using PQNode = QPair<double, int>;
-    std::priority_queue<
-        PQNode,
-        std::vector<PQNode>,
-        std::greater<PQNode>
-    > pq;
-
-    pq.push({0.0, sourceId});
+    // snapshot the backend into CSR, labels are parsed once, non-numeric are treated as 1
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+    const bool allNumeric = g.allNumeric;
 
-    // main dijkstra's loop (O((V + E) log V))
-    while (!pq.empty()) {
-        auto [d, u] = pq.top();
-        pq.pop();
+    // array heap search with a zero heuristic (O((V + E) log V)). a negative label
+    // breaks the settle-once rule, so switch to the label-correcting search
+    const bool negative = g.hasNegative;
+    const ShortestPathResult sp = negative ? spfaSearch(g, sourceId, targetId)
+                                           : dijkstraSearch(g, sourceId, targetId);
+    const QVector<double>& dist = sp.dist;
+    const QVector<int>& prev = sp.prev;
 
-        // skip if already processed
-        if (visited[u]) continue;
-        if (!m_dataHandler->nodeExists(u)) continue;
-
-        visited[u] = true;
-
-        if (u == targetId) break;
-
-        // update distances to neighbours
-        const QVector<EdgeInfo>& edges = m_dataHandler->getEdgesOf(u);
-        for (const EdgeInfo& e : edges) {
-            const int v = e.destination;
-            if (!m_dataHandler->nodeExists(v) || visited[v]) continue;
-
-            bool ok;
-            double w = e.label.isEmpty() ? 1.0 : e.label.toDouble(&ok);
-            if (!ok) w = 1.0;
-
-            double alt = d + w;
-            if (alt < dist[v]) {
-                dist[v] = alt;
-                prev[v] = u;
-                pq.push({alt, v});
-            }
-        }
-    }
+    const double INF = std::numeric_limits<double>::infinity();
+    const int N = g.nodeCount;
 
     // format results
     QStringList lines;
     lines << formatTimer(timer);
     lines << QString("Source: %1%2").arg(m_dataHandler->nodeLabel(sourceId))
              .arg(allNumeric ? "" : "  [non-numeric labels treated as weight 1]");
+    if (negative)
+        lines << QString("Negative weights found, ran Bellman-Ford (SPFA) instead: %1 scan(s).").arg(sp.settled);
+
+    if (!sp.negativeCycle.isEmpty()) {
+        QStringList cycle;
+        double weight = 0.0;
+        for (int i = 0; i < sp.negativeCycle.size(); ++i) {
+            const int a = sp.negativeCycle[i];
+            const int b = sp.negativeCycle[(i + 1) % sp.negativeCycle.size()];
+            cycle << m_dataHandler->nodeLabel(a);
+            for (int e = g.offsets[a]; e < g.offsets[a + 1]; ++e)
+                if (g.targets[e] == b) { weight += g.weights[e]; break; }
+        }
+        cycle << m_dataHandler->nodeLabel(sp.negativeCycle.first());
+
+        lines << "" << "Negative cycle reachable from the source, shortest distances are unbounded.";
+        if (!m_netSimWindow->directedEdges)
+            lines << "Edges are undirected, so any negative edge is a cycle of two.";
+        lines << QString("Cycle (weight %1): %2").arg(weight).arg(cycle.join(" -> "));
+        return lines.join("\n");
+    }
 
     if (targetId != -1) {
         lines << QString("Target: %1").arg(m_dataHandler->nodeLabel(targetId)) << "";
@@ -1821,71 +2176,1466 @@ QString AlgorithmPanel::algoDijkstra(int sourceId, int targetId)
 }
 
 // ---------------------------------------------------------------
-// Connected Components
+// A* search
 // ---------------------------------------------------------------
-QString AlgorithmPanel::algoConnectedComponents()
-{
-    QMap<int, int> comp;
-    int numComp = 0;
 
-    // start timer
-    QElapsedTimer timer;
-    timer.start();
+// ask for the declared minimum edge cost per pixel of layout distance
+bool AlgorithmPanel::askAStarParams(AStarParams& out) {
+    out = m_astarParams;
 
-    // run BFS from each unvisited node to find all components
-    const QVector<NodeInfo>* allNodes = m_dataHandler->getAllNodes();
-    for (int i = 0; i < allNodes->size(); ++i) {
-        if (!m_dataHandler->nodeExists(i) || comp.contains(i)) continue;
-        QQueue<int> q;
-        q.enqueue(i);
-        comp[i] = numComp;
+    QDialog dlg(this);
+    dlg.setWindowTitle("A* Parameters");
+    dlg.setMinimumWidth(320);
 
-        // BFS to find all nodes in this component
-        while (!q.isEmpty()) {
-            const int curId = q.dequeue();
-            const QVector<EdgeInfo> edges = m_dataHandler->getEdgesOf(curId);
-            for (const EdgeInfo& e : edges) {
-                if (!comp.contains(e.destination)) {
-                    comp[e.destination] = numComp;
-                    q.enqueue(e.destination);
-                }
-            }
-        }
-        ++numComp;
-    }
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
 
-    // group node labels by component
-    QMap<int, QStringList> groups;
-    for (auto it = comp.cbegin(); it != comp.cend(); ++it)
-        groups[it.value()] << m_dataHandler->nodeLabel(it.key());
+    auto* descLbl = new QLabel(
+        "Guides the search with the straight-line distance to the target.\n"
+        "The scale must not exceed the cheapest edge cost per pixel,\n"
+        "otherwise it is lowered to keep the path exact.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
 
+    auto* scaleSpin = new QDoubleSpinBox;
+    scaleSpin->setRange(0.0, 1000.0);
+    scaleSpin->setDecimals(4);
+    scaleSpin->setSingleStep(0.01);
+    scaleSpin->setValue(out.costPerUnit);
+    scaleSpin->setSuffix(" / px");
+    scaleSpin->setToolTip("Minimum edge cost per unit of layout length. 0 runs plain Dijkstra.");
+    form->addRow("Min cost per unit length:", scaleSpin);
 
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
 
-    QStringList lines;
-    lines << formatTimer(timer);
-    int largestComp = -1, largestSize = 0;
-    for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
-        if (it.value().size() > largestSize) {
-            largestSize = it.value().size();
-            largestComp = it.key();
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.costPerUnit = scaleSpin->value();
+    m_astarParams = out;
+    return true;
+}
+
+// scene position of every backend node, members of a contracted node share its position
+QVector<QPointF> AlgorithmPanel::backendPositions(QVector<bool>& hasPos) const
+{
+    const int N = m_dataHandler->getAllNodes()->size();
+    QVector<QPointF> pos(N, QPointF(0, 0));
+    hasPos.fill(false, N);
+
+    for (NetworkNode* node : *m_nodeItems) {
+        if (!node) continue;
+        if (node->isContracted()) {
+            for (int memberId : node->memberFrontIds()) {
+                if (memberId < 0 || memberId >= N) continue;
+                pos[memberId] = node->pos();
+                hasPos[memberId] = true;
+            }
+        } else if (node->nodeFrontId >= 0 && node->nodeFrontId < N) {
+            pos[node->nodeFrontId] = node->pos();
+            hasPos[node->nodeFrontId] = true;
         }
     }
+    return pos;
+}
 
-    if (largestComp != -1) {
-        lines << QString("Largest component: [%1] with %2 node(s)")
-                    .arg(largestComp + 1)
-                    .arg(largestSize);
-        lines << QString("First node: %1")
-                    .arg(groups[largestComp].first());
+// A* with h(v) = scale * |pos(v) - pos(target)|, compared against plain Dijkstra
+QString AlgorithmPanel::algoAStar(int sourceId, int targetId, const AStarParams& params)
+{
+    if (sourceId == -1 || !m_dataHandler->nodeExists(sourceId)) return "No source node.";
+    if (targetId == -1 || !m_dataHandler->nodeExists(targetId)) return "A* needs a target node.";
+
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+    if (g.hasNegative)
+        return "A* needs non-negative edge weights, negative labels found.";
+
+    QVector<bool> hasPos;
+    const QVector<QPointF> pos = backendPositions(hasPos);
+
+    // the heuristic is only a lower bound if every node has a position
+    bool allPlaced = true;
+    for (int u = 0; u < g.nodeCount; ++u)
+        if (g.alive[u] && !hasPos[u]) { allPlaced = false; break; }
+
+    // and if no edge costs less than scale * its drawn length,
+    // so lower the declared scale to the largest one the edges allow
+    double scale = allPlaced ? params.costPerUnit : 0.0;
+    int violations = 0;
+    if (scale > 0.0) {
+        double maxScale = std::numeric_limits<double>::infinity();
+        for (int u = 0; u < g.nodeCount; ++u) {
+            for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                const int v = g.targets[i];
+                const double len = QLineF(pos[u], pos[v]).length();
+                if (len <= 0.0) continue;
+                if (g.weights[i] < scale * len) ++violations;
+                maxScale = qMin(maxScale, g.weights[i] / len);
+            }
+        }
+        if (violations > 0) scale = maxScale;
     }
 
-    lines << QString("%1 connected component(s):\n").arg(numComp);
+    const QPointF targetPos = pos[targetId];
+    auto heuristic = [&](int v) {
+        const double dx = pos[v].x() - targetPos.x();
+        const double dy = pos[v].y() - targetPos.y();
+        return scale * std::sqrt(dx * dx + dy * dy);
+    };
 
-    for (int i = 0; i < numComp; ++i)
-        lines << QString("  [%1]  { %2 }").arg(i + 1).arg(groups[i].join(", "));
+    // A* run
+    QElapsedTimer timer;
+    timer.start();
+    const ShortestPathResult astar = heapSearch(g, sourceId, targetId, heuristic, true);
+    const qint64 astarNs = timer.nsecsElapsed();
+
+    // plain Dijkstra on the same engine for comparison
+    timer.restart();
+    const ShortestPathResult plain = dijkstraSearch(g, sourceId, targetId);
+    const qint64 plainNs = timer.nsecsElapsed();
+
+    // format results
+    QStringList lines;
+    lines << QString("Source: %1%2").arg(m_dataHandler->nodeLabel(sourceId))
+             .arg(g.allNumeric ? "" : "  [non-numeric labels treated as weight 1]");
+    lines << QString("Target: %1").arg(m_dataHandler->nodeLabel(targetId)) << "";
+
+    if (!astar.reachedTarget) {
+        lines << "Target is unreachable from source.";
+    } else {
+        QStringList path;
+        for (int id : astar.pathTo(targetId))
+            path << m_dataHandler->nodeLabel(id);
+        lines << QString("Distance: %1").arg(QString::number(astar.dist[targetId], 'f', 2));
+        lines << QString("Path: %1").arg(path.join(" -> "));
+    }
+    lines << "";
+
+    if (!allPlaced)
+        lines << "Heuristic: off, some nodes have no scene position.";
+    else if (violations > 0)
+        lines << QString("Heuristic: %1 / px (declared %2, lowered, %3 edge(s) cheaper than declared)")
+                    .arg(scale, 0, 'g', 4).arg(params.costPerUnit, 0, 'g', 4).arg(violations);
+    else
+        lines << QString("Heuristic: %1 / px").arg(scale, 0, 'g', 4);
+
+    lines << QString("Expanded   A*: %1 node(s)   time %2").arg(astar.settled).arg(formatNsecs(astarNs));
+    lines << QString("Expanded Dijk: %1 node(s)   time %2").arg(plain.settled).arg(formatNsecs(plainNs));
+    if (plain.settled > 0)
+        lines << QString("A* expanded %1% of Dijkstra's nodes.")
+                    .arg(100.0 * astar.settled / plain.settled, 0, 'f', 1);
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// ALT landmark oracle
+// ---------------------------------------------------------------
+
+// ask for the number of landmarks and how to pick them
+bool AlgorithmPanel::askAltParams(AltParams& out) {
+    out = m_altParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("ALT Landmark Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(
+        "Precomputes distances from and to a few landmark nodes.\n"
+        "Later s–t queries use them as A* lower bounds until the graph changes.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* countSpin = new QSpinBox;
+    countSpin->setRange(1, 64);
+    countSpin->setValue(out.landmarks);
+    form->addRow("Landmarks:", countSpin);
+
+    auto* strategyCbo = new QComboBox;
+    strategyCbo->addItem("Farthest point", (int)LandmarkStrategy::FarthestPoint);
+    strategyCbo->addItem("Highest degree", (int)LandmarkStrategy::HighestDegree);
+    strategyCbo->setCurrentIndex(strategyCbo->findData((int)out.strategy));
+    form->addRow("Selection:", strategyCbo);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.landmarks = countSpin->value();
+    out.strategy = (LandmarkStrategy)strategyCbo->currentData().toInt();
+    m_altParams = out;
+    return true;
+}
+
+// (re)build the landmark distance arrays for the current graph
+QString AlgorithmPanel::algoBuildAlt(const AltParams& params)
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+    if (g.hasNegative) {
+        m_altOracle.clear();
+        return "ALT needs non-negative edge weights, negative labels found.";
+    }
+
+    const bool symmetric = !m_netSimWindow->directedEdges;
+    m_altOracle.build(g, m_dataHandler->revision(), params.landmarks, params.strategy, symmetric);
+
+    QStringList names;
+    for (int id : m_altOracle.landmarks())
+        names << m_dataHandler->nodeLabel(id);
+
+    QStringList lines;
+    lines << QString("\nPreprocessing: %1").arg(formatNsecs(m_altOracle.buildNsecs()));
+    lines << QString("Landmarks  : %1 (%2)").arg(names.size())
+             .arg(params.strategy == LandmarkStrategy::FarthestPoint ? "farthest point" : "highest degree");
+    lines << QString("Searches   : %1 on %2 thread(s)")
+             .arg(m_altOracle.searches())
+             .arg(m_altOracle.threads());
+    lines << QString("Memory     : %1 KB")
+             .arg((symmetric ? 1 : 2) * (qint64)names.size() * g.nodeCount * sizeof(double) / 1024);
+    lines << QString("Nodes      : %1").arg(names.join(", "));
+    return lines.join("\n");
+}
+
+// s–t query through the oracle, rebuilding it first if the graph changed
+QString AlgorithmPanel::algoAlt(int sourceId, int targetId)
+{
+    if (sourceId == -1 || !m_dataHandler->nodeExists(sourceId)) return "No source node.";
+    if (targetId == -1 || !m_dataHandler->nodeExists(targetId)) return "ALT needs a target node.";
+
+    QStringList lines;
+    const bool symmetric = !m_netSimWindow->directedEdges;
+    if (!m_altOracle.isValid(m_dataHandler->revision(), symmetric)) {
+        QString built = algoBuildAlt(m_altParams);
+        if (!m_altOracle.isValid(m_dataHandler->revision(), symmetric)) return built;
+        lines << QString("Landmarks rebuilt (graph changed): %1 in %2")
+                    .arg(m_altOracle.landmarks().size())
+                    .arg(formatNsecs(m_altOracle.buildNsecs()));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const ShortestPathResult alt = m_altOracle.query(sourceId, targetId);
+    const qint64 altNs = timer.nsecsElapsed();
+
+    timer.restart();
+    const ShortestPathResult plain = dijkstraSearch(m_altOracle.graph(), sourceId, targetId);
+    const qint64 plainNs = timer.nsecsElapsed();
+
+    lines << QString("Source: %1").arg(m_dataHandler->nodeLabel(sourceId));
+    lines << QString("Target: %1").arg(m_dataHandler->nodeLabel(targetId)) << "";
+    if (!alt.reachedTarget) {
+        lines << "Target is unreachable from source.";
+    } else {
+        QStringList path;
+        for (int id : alt.pathTo(targetId))
+            path << m_dataHandler->nodeLabel(id);
+        lines << QString("Distance: %1").arg(QString::number(alt.dist[targetId], 'f', 2));
+        lines << QString("Path: %1").arg(path.join(" -> "));
+    }
+    lines << "";
+    lines << QString("Expanded  ALT: %1 node(s)   time %2").arg(alt.settled).arg(formatNsecs(altNs));
+    lines << QString("Expanded Dijk: %1 node(s)   time %2").arg(plain.settled).arg(formatNsecs(plainNs));
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Contraction hierarchy
+// ---------------------------------------------------------------
+
+// contract the whole graph and report the hierarchy stats
+QString AlgorithmPanel::algoBuildCh()
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+    if (g.hasNegative) {
+        m_ch.clear();
+        return "CH needs non-negative edge weights, negative labels found.";
+    }
+
+    m_ch.build(g, m_dataHandler->revision());
+
+    // one list of random pairs timed with both searches
+    QVector<int> aliveIds;
+    for (int v = 0; v < g.nodeCount; ++v)
+        if (g.alive[v]) aliveIds.append(v);
+
+    const int samples = 20;
+    QVector<QPair<int,int>> pairs;
+    if (!aliveIds.isEmpty()) {
+        pairs.reserve(samples);
+        for (int i = 0; i < samples; ++i)
+            pairs.append(qMakePair(aliveIds[std::rand() % aliveIds.size()], aliveIds[std::rand() % aliveIds.size()]));
+    }
+
+    const qint64 chNs = m_ch.benchmark(pairs);
+
+    qint64 dijkstraNs = 0;
+    if (!pairs.isEmpty()) {
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto& pair : pairs)
+            dijkstraSearch(g, pair.first, pair.second);
+        dijkstraNs = timer.nsecsElapsed() / pairs.size();
+    }
+
+    QStringList lines;
+    lines << QString("\nPreprocessing: %1").arg(formatNsecs(m_ch.buildNsecs()));
+    lines << QString("Edges       : %1").arg(m_ch.originalEdges());
+    lines << QString("Shortcuts   : %1 (%2% of edges)")
+             .arg(m_ch.shortcuts())
+             .arg(m_ch.originalEdges() ? 100.0 * m_ch.shortcuts() / m_ch.originalEdges() : 0.0, 0, 'f', 1);
+    lines << QString("Avg query CH: %1 over %2 random pair(s)").arg(formatNsecs(chNs)).arg(pairs.size());
+    lines << QString("Avg Dijkstra: %1 over the same pair(s)").arg(formatNsecs(dijkstraNs));
+    return lines.join("\n");
+}
+
+// s–t query on the hierarchy, rebuilding it first if the graph changed
+QString AlgorithmPanel::algoCh(int sourceId, int targetId)
+{
+    if (sourceId == -1 || !m_dataHandler->nodeExists(sourceId)) return "No source node.";
+    if (targetId == -1 || !m_dataHandler->nodeExists(targetId)) return "CH needs a target node.";
+
+    QStringList lines;
+    if (!m_ch.isValid(m_dataHandler->revision())) {
+        QString built = algoBuildCh();
+        if (!m_ch.isValid(m_dataHandler->revision())) return built;
+        lines << QString("Hierarchy rebuilt (graph changed): %1 shortcut(s) in %2")
+                    .arg(m_ch.shortcuts())
+                    .arg(formatNsecs(m_ch.buildNsecs()));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const ContractionHierarchy::QueryResult r = m_ch.query(sourceId, targetId);
+    const qint64 chNs = timer.nsecsElapsed();
+
+    lines << QString("Source: %1").arg(m_dataHandler->nodeLabel(sourceId));
+    lines << QString("Target: %1").arg(m_dataHandler->nodeLabel(targetId)) << "";
+    if (r.path.isEmpty()) {
+        lines << "Target is unreachable from source.";
+    } else {
+        QStringList path;
+        for (int id : r.path)
+            path << m_dataHandler->nodeLabel(id);
+        lines << QString("Distance: %1").arg(QString::number(r.distance, 'f', 2));
+        lines << QString("Path: %1").arg(path.join(" -> "));
+    }
+    lines << "";
+    lines << QString("Settled: %1 node(s)   time %2").arg(r.settled).arg(formatNsecs(chNs));
+    lines << QString("Average query: %1 over %2 quer(ies) since rebuild")
+                .arg(formatNsecs(m_ch.averageQueryNsecs())).arg(m_ch.queryCount());
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Connected Components
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoConnectedComponents()
+{
+    QMap<int, int> comp;
+    int numComp = 0;
+
+    // start timer
+    QElapsedTimer timer;
+    timer.start();
+
+    // run BFS from each unvisited node to find all components
+    const QVector<NodeInfo>* allNodes = m_dataHandler->getAllNodes();
+    for (int i = 0; i < allNodes->size(); ++i) {
+        if (!m_dataHandler->nodeExists(i) || comp.contains(i)) continue;
+        QQueue<int> q;
+        q.enqueue(i);
+        comp[i] = numComp;
+
+        // BFS to find all nodes in this component
+        while (!q.isEmpty()) {
+            const int curId = q.dequeue();
+            const QVector<EdgeInfo> edges = m_dataHandler->getEdgesOf(curId);
+            for (const EdgeInfo& e : edges) {
+                if (!comp.contains(e.destination)) {
+                    comp[e.destination] = numComp;
+                    q.enqueue(e.destination);
+                }
+            }
+        }
+        ++numComp;
+    }
+
+    // group node labels by component
+    QMap<int, QStringList> groups;
+    for (auto it = comp.cbegin(); it != comp.cend(); ++it)
+        groups[it.value()] << m_dataHandler->nodeLabel(it.key());
+
+
+
+    QStringList lines;
+    lines << formatTimer(timer);
+    int largestComp = -1, largestSize = 0;
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
+        if (it.value().size() > largestSize) {
+            largestSize = it.value().size();
+            largestComp = it.key();
+        }
+    }
+
+    if (largestComp != -1) {
+        lines << QString("Largest component: [%1] with %2 node(s)")
+                    .arg(largestComp + 1)
+                    .arg(largestSize);
+        lines << QString("First node: %1")
+                    .arg(groups[largestComp].first());
+    }
+
+    lines << QString("%1 connected component(s):\n").arg(numComp);
+
+    for (int i = 0; i < numComp; ++i)
+        lines << QString("  [%1]  { %2 }").arg(i + 1).arg(groups[i].join(", "));
 
     lines << (numComp == 1 ? "\nGraph is fully connected."
                         : QString("\nGraph is disconnected (%1 components).").arg(numComp));
 
     return lines.join("\n");
-}
\ No newline at end of file
+}
+// ---------------------------------------------------------------
+// Hop distances (multi-source BFS)
+// ---------------------------------------------------------------
+
+// one BFS per node, run 64 at a time, edge weights are ignored
+QString AlgorithmPanel::algoHopDistances()
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QVector<int> sources;
+    for (int v = 0; v < g.nodeCount; ++v)
+        if (g.alive[v]) sources.append(v);
+    if (sources.isEmpty()) return "Graph is empty.";
+
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<HopStats> stats = multiSourceHopStats(g, sources);
+    const qint64 msBfsNs = timer.nsecsElapsed();
+
+    // totals over every reachable ordered pair
+    qint64 pairSum = 0, pairs = 0;
+    int diameter = 0, diameterSource = -1;
+    for (int i = 0; i < sources.size(); ++i) {
+        pairSum += stats[i].distanceSum;
+        pairs += stats[i].reached - 1;
+        if (stats[i].eccentricity > diameter || diameterSource == -1) {
+            diameter = stats[i].eccentricity;
+            diameterSource = sources[i];
+        }
+    }
+
+    // closeness scaled by the reached fraction so small components do not win
+    const int N = sources.size();
+    QVector<QPair<double,int>> closeness;
+    for (int i = 0; i < N; ++i) {
+        const HopStats& h = stats[i];
+        double c = 0.0;
+        if (h.distanceSum > 0 && N > 1)
+            c = double(h.reached - 1) / h.distanceSum * double(h.reached - 1) / (N - 1);
+        closeness.append({c, sources[i]});
+    }
+    const int top = qMin(10, closeness.size());
+    std::partial_sort(closeness.begin(), closeness.begin() + top, closeness.end(),
+                      [](const QPair<double,int>& a, const QPair<double,int>& b) { return a.first > b.first; });
+
+    QStringList lines;
+    lines << QString("\nTime: %1 (%2 source(s), %3 sweep(s) of %4 on %5 thread(s))")
+             .arg(formatNsecs(msBfsNs)).arg(N)
+             .arg((N + MSBFS_WIDTH - 1) / MSBFS_WIDTH).arg(MSBFS_WIDTH)
+             .arg(parallelWorkers((N + MSBFS_WIDTH - 1) / MSBFS_WIDTH));
+    lines << QString("Reachable pairs : %1 of %2").arg(pairs).arg(qint64(N) * (N - 1));
+    lines << QString("Average hops    : %1").arg(pairs ? double(pairSum) / pairs : 0.0, 0, 'f', 3);
+    lines << QString("Diameter (hops) : %1 from %2").arg(diameter).arg(m_dataHandler->nodeLabel(diameterSource));
+    lines << "" << "Highest closeness:";
+    for (int i = 0; i < top; ++i)
+        lines << QString("  %1  %2").arg(closeness[i].first, 0, 'f', 4)
+                                     .arg(m_dataHandler->nodeLabel(closeness[i].second));
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Betweenness centrality
+// ---------------------------------------------------------------
+
+// ask for exact vs sampled and whether edge labels are weights
+bool AlgorithmPanel::askBetweennessParams(BetweennessParams& out) {
+    out = m_betweennessParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Betweenness Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(
+        "Counts the shortest paths passing through each node.\n"
+        "Sampling k sources gives an estimate with a standard error, 0 runs every source.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* samplesSpin = new QSpinBox;
+    samplesSpin->setRange(0, 1000000);
+    samplesSpin->setSpecialValueText("All (exact)");
+    samplesSpin->setValue(out.samples);
+    form->addRow("Sources:", samplesSpin);
+
+    auto* weightedChk = new QCheckBox("Use edge labels as weights");
+    weightedChk->setChecked(out.weighted);
+    form->addRow("", weightedChk);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.samples = samplesSpin->value();
+    out.weighted = weightedChk->isChecked();
+    m_betweennessParams = out;
+    return true;
+}
+
+// store a per-node result in the DataHandler, show it as a node column and colour by it
+void AlgorithmPanel::publishNodeMetric(const QString& name, const QVector<double>& values)
+{
+    m_dataHandler->setNodeMetric(name, values);
+    if (m_netSimWindow->graphPanel) m_netSimWindow->graphPanel->refreshMetricColumns();
+    m_netSimWindow->colourNodesByMetric(name);
+}
+
+QString AlgorithmPanel::algoBetweenness(const BetweennessParams& params)
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+    QStringList lines;
+
+    // Brandes needs strictly positive weights, otherwise count hops
+    bool weighted = params.weighted;
+    if (weighted) {
+        for (double w : g.weights) {
+            if (w <= 0.0) {
+                weighted = false;
+                lines << "Zero or negative edge weights found, counting hops instead.";
+                break;
+            }
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const BetweennessResult r = betweennessCentrality(g, weighted, !m_netSimWindow->directedEdges,
+                                                      params.samples, (quint32)std::rand());
+    const qint64 ns = timer.nsecsElapsed();
+    if (r.sources == 0) return "Graph is empty.";
+
+    // removed ids read as unknown rather than 0
+    QVector<double> column = r.score;
+    for (int v = 0; v < g.nodeCount; ++v)
+        if (!g.alive[v]) column[v] = NAN;
+    publishNodeMetric("Betweenness", column);
+
+    QVector<int> ranked;
+    for (int v = 0; v < g.nodeCount; ++v)
+        if (g.alive[v]) ranked.append(v);
+    const int top = qMin(10, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + top, ranked.end(),
+                      [&r](int a, int b) { return r.score[a] > r.score[b]; });
+
+    lines << QString("\nTime: %1 (%2 source(s) on %3 thread(s), %4)")
+             .arg(formatNsecs(ns)).arg(r.sources).arg(parallelWorkers(r.sources))
+             .arg(weighted ? "weighted" : "hop counts");
+    if (r.sampled) {
+        // error relative to the largest score, the usual way sampled rankings are judged
+        double maxScore = 0.0, maxError = 0.0;
+        for (int v : ranked) {
+            maxScore = qMax(maxScore, r.score[v]);
+            maxError = qMax(maxError, r.stdError[v]);
+        }
+        lines << QString("Sampled estimate, largest standard error %1 (%2% of the top score)")
+                 .arg(maxError, 0, 'f', 2)
+                 .arg(maxScore > 0.0 ? 100.0 * maxError / maxScore : 0.0, 0, 'f', 1);
+    } else {
+        lines << "Exact scores.";
+    }
+    lines << "Written to the node table column \"Betweenness\"." << "" << "Highest betweenness:";
+    for (int i = 0; i < top; ++i) {
+        const int v = ranked[i];
+        QString row = QString("  %1  %2").arg(r.score[v], 0, 'f', 2).arg(m_dataHandler->nodeLabel(v));
+        if (r.sampled) row += QString("  (± %1)").arg(r.stdError[v], 0, 'f', 2);
+        lines << row;
+    }
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// PageRank / eigenvector centrality
+// ---------------------------------------------------------------
+
+// convergence settings, damping and personalisation only apply to PageRank
+bool AlgorithmPanel::askPageRankParams(PageRankParams& out, bool eigenvector) {
+    out = m_pageRankParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle(eigenvector ? "Eigenvector Centrality Parameters" : "PageRank Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(eigenvector
+        ? "Repeats x = Ax until the change between iterations (L1) drops below the tolerance."
+        : "Random surfer ranking. With personalisation the surfer only restarts\n"
+          "at the selected nodes, ranking nodes by closeness to them.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    QDoubleSpinBox* dampingSpin = nullptr;
+    QCheckBox* personaliseChk = nullptr;
+    if (!eigenvector) {
+        dampingSpin = new QDoubleSpinBox;
+        dampingSpin->setRange(0.0, 0.99);
+        dampingSpin->setSingleStep(0.05);
+        dampingSpin->setDecimals(2);
+        dampingSpin->setValue(out.damping);
+        form->addRow("Damping:", dampingSpin);
+
+        personaliseChk = new QCheckBox("Restart at selected nodes only");
+        personaliseChk->setChecked(out.personaliseSelection);
+        form->addRow("", personaliseChk);
+    }
+
+    auto* tolSpin = new QDoubleSpinBox;
+    tolSpin->setRange(1e-9, 1e-2);
+    tolSpin->setDecimals(9);
+    tolSpin->setSingleStep(1e-6);
+    tolSpin->setValue(out.tolerance);
+    form->addRow("Tolerance:", tolSpin);
+
+    auto* iterSpin = new QSpinBox;
+    iterSpin->setRange(1, 10000);
+    iterSpin->setValue(out.maxIterations);
+    form->addRow("Max iterations:", iterSpin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    if (!eigenvector) {
+        out.damping = dampingSpin->value();
+        out.personaliseSelection = personaliseChk->isChecked();
+    }
+    out.tolerance = tolSpin->value();
+    out.maxIterations = iterSpin->value();
+    m_pageRankParams = out;
+    return true;
+}
+
+// shared report: convergence, timing and the top scores
+QString AlgorithmPanel::formatPowerIteration(const QString& metric, const PowerIterationResult& r, qint64 nsecs) const
+{
+    QVector<int> ranked;
+    for (int v = 0; v < r.score.size(); ++v)
+        if (m_dataHandler->nodeExists(v)) ranked.append(v);
+    const int top = qMin(10, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + top, ranked.end(),
+                      [&r](int a, int b) { return r.score[a] > r.score[b]; });
+
+    QStringList lines;
+    lines << QString("\nTime: %1 (%2 per iteration)")
+             .arg(formatNsecs(nsecs)).arg(formatNsecs(r.iterations ? nsecs / r.iterations : 0));
+    lines << QString("Iterations: %1, L1 residual %2%3")
+             .arg(r.iterations).arg(r.residual, 0, 'g', 3)
+             .arg(r.converged ? "" : "  (not converged, raise max iterations)");
+    lines << QString("Written to the node table column \"%1\".").arg(metric) << "";
+    lines << QString("Highest %1:").arg(metric);
+    for (int i = 0; i < top; ++i)
+        lines << QString("  %1  %2").arg(r.score[ranked[i]], 0, 'f', 6).arg(m_dataHandler->nodeLabel(ranked[i]));
+    return lines.join("\n");
+}
+
+QString AlgorithmPanel::algoPageRank(const PageRankParams& params)
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    // personalisation from the selected nodes, contracted nodes stand for their members
+    QVector<double> personalisation;
+    int personalised = 0;
+    if (params.personaliseSelection) {
+        personalisation.fill(0.0, g.nodeCount);
+        for (auto it = m_nodeItems->cbegin(); it != m_nodeItems->cend(); ++it) {
+            if (!it.value()->isSelected()) continue;
+            const QVector<int> ids = it.key() >= 0 ? QVector<int>{ it.key() } : m_netSimWindow->getMembers(it.key());
+            for (int id : ids) {
+                if (id < 0 || id >= g.nodeCount || personalisation[id] > 0.0) continue;
+                personalisation[id] = 1.0;
+                ++personalised;
+            }
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const PowerIterationResult r = pageRank(g, params.damping, personalisation,
+                                            params.tolerance, params.maxIterations);
+    const qint64 ns = timer.nsecsElapsed();
+    if (r.iterations == 0) return "Graph is empty.";
+
+    publishNodeMetric("PageRank", r.score);
+
+    QString note;
+    if (params.personaliseSelection)
+        note = personalised > 0 ? QString("Personalised on %1 selected node(s).\n").arg(personalised)
+                                : "No nodes selected, using uniform restarts.\n";
+    return note + formatPowerIteration("PageRank", r, ns);
+}
+
+QString AlgorithmPanel::algoEigenvector(const PageRankParams& params)
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const PowerIterationResult r = eigenvectorCentrality(g, params.tolerance, params.maxIterations);
+    const qint64 ns = timer.nsecsElapsed();
+    if (r.iterations == 0) return "Graph is empty.";
+
+    publishNodeMetric("Eigenvector", r.score);
+    return formatPowerIteration("Eigenvector", r, ns);
+}
+
+// ---------------------------------------------------------------
+// Triangles / clustering coefficient
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoTriangles()
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const TriangleResult r = countTriangles(g);
+    const qint64 ns = timer.nsecsElapsed();
+
+    // counts as doubles for the metric store, removed ids unknown
+    QVector<double> counts(g.nodeCount, NAN), clustering(g.nodeCount, NAN);
+    for (int v = 0; v < g.nodeCount; ++v) {
+        if (!g.alive[v]) continue;
+        counts[v] = r.perNode[v];
+        clustering[v] = r.clustering[v];
+    }
+    m_dataHandler->setNodeMetric("Triangles", counts);
+    publishNodeMetric("Clustering", clustering);
+
+    QVector<int> ranked;
+    for (int v = 0; v < g.nodeCount; ++v)
+        if (g.alive[v]) ranked.append(v);
+    const int top = qMin(10, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + top, ranked.end(),
+                      [&r](int a, int b) { return r.perNode[a] > r.perNode[b]; });
+
+    QStringList lines;
+    lines << QString("\nTime: %1 on %2 thread(s)").arg(formatNsecs(ns)).arg(parallelWorkers((g.nodeCount + 255) / 256));
+    lines << QString("Triangles           : %1").arg(r.triangles);
+    lines << QString("Transitivity        : %1").arg(r.transitivity, 0, 'f', 4);
+    lines << QString("Average clustering  : %1").arg(r.averageClustering, 0, 'f', 4);
+    if (m_netSimWindow->directedEdges)
+        lines << "Edge directions are ignored.";
+    lines << "Written to the node table columns \"Triangles\" and \"Clustering\"." << "";
+    lines << "Most triangles:";
+    for (int i = 0; i < top; ++i)
+        lines << QString("  %1  (c = %2)  %3").arg(r.perNode[ranked[i]])
+                 .arg(r.clustering[ranked[i]], 0, 'f', 3).arg(m_dataHandler->nodeLabel(ranked[i]));
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// k-core decomposition
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoKCore()
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    // sequential bucket peeling and the parallel h-index iteration, timed side by side
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<int> core = coreNumbers(g);
+    const qint64 bzNs = timer.nsecsElapsed();
+
+    int rounds = 0;
+    timer.restart();
+    const QVector<int> parallelCore = coreNumbersParallel(g, &rounds);
+    const qint64 parallelNs = timer.nsecsElapsed();
+    Q_ASSERT(parallelCore == core);
+
+    QVector<double> column(g.nodeCount, NAN);
+    QMap<int, int> shellSizes;
+    int degeneracy = 0;
+    for (int v = 0; v < g.nodeCount; ++v) {
+        if (core[v] < 0) continue;
+        column[v] = core[v];
+        ++shellSizes[core[v]];
+        degeneracy = qMax(degeneracy, core[v]);
+    }
+    if (shellSizes.isEmpty()) return "Graph is empty.";
+    publishNodeMetric("Core", column);
+
+    QStringList lines;
+    lines << QString("\nBucket peeling   : %1").arg(formatNsecs(bzNs));
+    lines << QString("Parallel h-index : %1 (%2 sweep(s) on %3 thread(s))")
+             .arg(formatNsecs(parallelNs)).arg(rounds)
+             .arg(parallelWorkers((g.nodeCount + 511) / 512));
+    lines << QString("Degeneracy (max core): %1").arg(degeneracy);
+    lines << "Written to the node table column \"Core\"." << "";
+    lines << "Shell sizes (core number: nodes):";
+    for (auto it = shellSizes.cbegin(); it != shellSizes.cend(); ++it)
+        lines << QString("  %1: %2").arg(it.key(), 3).arg(it.value());
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Strongly connected components
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoStronglyConnected()
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const SccResult r = stronglyConnectedComponents(g);
+    const qint64 ns = timer.nsecsElapsed();
+    if (r.count == 0) return "Graph is empty.";
+
+    // DAG sources and sinks
+    QVector<bool> hasIn(r.count, false);
+    for (int c : r.dagTargets) hasIn[c] = true;
+    int sources = 0, sinks = 0;
+    for (int c = 0; c < r.count; ++c) {
+        if (!hasIn[c]) ++sources;
+        if (r.dagOffsets[c] == r.dagOffsets[c + 1]) ++sinks;
+    }
+
+    QVector<QStringList> members(r.count);
+    for (int v = 0; v < g.nodeCount; ++v)
+        if (r.component[v] != -1) members[r.component[v]] << m_dataHandler->nodeLabel(v);
+
+    // largest components first
+    QVector<int> order(r.count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&r](int a, int b) { return r.sizes[a] > r.sizes[b]; });
+
+    QStringList lines;
+    lines << formatNsecs(ns).prepend("\nTime: ");
+    lines << QString("%1 strongly connected component(s), largest has %2 node(s).")
+             .arg(r.count).arg(r.sizes[order[0]]);
+    lines << QString("Condensation DAG: %1 node(s), %2 edge(s), %3 source(s), %4 sink(s).")
+             .arg(r.count).arg(r.dagTargets.size()).arg(sources).arg(sinks);
+    lines << "";
+
+    const int shown = qMin(20, r.count);
+    for (int i = 0; i < shown; ++i) {
+        const int c = order[i];
+        QStringList labels = members[c].mid(0, 10);
+        if (members[c].size() > 10) labels << QString("… %1 more").arg(members[c].size() - 10);
+
+        QStringList next;
+        for (int e = r.dagOffsets[c]; e < r.dagOffsets[c + 1] && next.size() < 8; ++e)
+            next << QString::number(r.dagTargets[e] + 1);
+
+        lines << QString("  [%1]  %2 node(s) { %3 }%4")
+                 .arg(c + 1).arg(r.sizes[c]).arg(labels.join(", "))
+                 .arg(next.isEmpty() ? "" : QString("  -> [%1]").arg(next.join("], [")));
+    }
+    if (shown < r.count)
+        lines << QString("  … %1 more component(s)").arg(r.count - shown);
+
+    lines << (r.count == 1 ? "\nGraph is strongly connected."
+                           : "\nComponents are numbered in topological order of the DAG.");
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Articulation points and bridges
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoArticulation()
+{
+    if (m_dataHandler->nodeCount() == 0) return "Graph is empty.";
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const BiconnectedResult r = biconnectedComponents(g);
+    const qint64 ns = timer.nsecsElapsed();
+
+    QVector<double> cutColumn(g.nodeCount, NAN), blockColumn(g.nodeCount, NAN);
+    QVector<int> cuts;
+    for (int v = 0; v < g.nodeCount; ++v) {
+        if (!g.alive[v]) continue;
+        cutColumn[v] = r.articulation[v] ? 1.0 : 0.0;
+        blockColumn[v] = r.blocksPerNode[v];
+        if (r.articulation[v]) cuts.append(v);
+    }
+    m_dataHandler->setNodeMetric("Cut Vertex", cutColumn);
+    publishNodeMetric("Blocks", blockColumn);
+
+    // highlight the cut vertices and bridges that are visible on their own
+    QHash<int, NetworkNode*> cutNodes;
+    for (int v : cuts) {
+        const int frontId = m_netSimWindow->backIdToFrontId(v);
+        if (NetworkNode* node = m_nodeItems->value(frontId)) cutNodes.insert(frontId, node);
+    }
+    QHash<QPair<int,int>, NetworkEdge*> bridgeEdges;
+    for (const QPair<int,int>& b : r.bridges) {
+        const int fu = m_netSimWindow->backIdToFrontId(b.first);
+        const int fv = m_netSimWindow->backIdToFrontId(b.second);
+        if (fu == fv) continue;
+        NetworkEdge* edge = m_edgeItems->value(qMakePair(fu, fv), m_edgeItems->value(qMakePair(fv, fu)));
+        if (edge) bridgeEdges.insert(qMakePair(fu, fv), edge);
+    }
+    emit requestHighlightNodes(cutNodes);
+    emit requestHighlightEdges(bridgeEdges);
+
+    // the most load bearing cut vertices first
+    std::stable_sort(cuts.begin(), cuts.end(), [&r](int a, int b) { return r.blocksPerNode[a] > r.blocksPerNode[b]; });
+
+    int largestBlock = 0;
+    for (int b = 0; b < r.blockCount(); ++b)
+        largestBlock = qMax(largestBlock, r.blockOffsets[b + 1] - r.blockOffsets[b]);
+
+    QStringList lines;
+    lines << QString("\nTime: %1").arg(formatNsecs(ns));
+    lines << QString("Cut vertices: %1   Bridges: %2").arg(cuts.size()).arg(r.bridges.size());
+    lines << QString("Biconnected blocks: %1, largest has %2 node(s).").arg(r.blockCount()).arg(largestBlock);
+    if (m_netSimWindow->directedEdges)
+        lines << "Edge direction is ignored, failures cut the link both ways.";
+    lines << "Written to the node table columns \"Cut Vertex\" and \"Blocks\"." << "";
+
+    if (!cuts.isEmpty()) {
+        lines << "Cut vertices (blocks joined):";
+        for (int i = 0; i < qMin(20, cuts.size()); ++i)
+            lines << QString("  %1  (%2)").arg(m_dataHandler->nodeLabel(cuts[i])).arg(r.blocksPerNode[cuts[i]]);
+        if (cuts.size() > 20) lines << QString("  … %1 more").arg(cuts.size() - 20);
+        lines << "";
+    }
+    if (!r.bridges.isEmpty()) {
+        lines << "Bridges:";
+        for (int i = 0; i < qMin(20, r.bridges.size()); ++i)
+            lines << QString("  %1 – %2").arg(m_dataHandler->nodeLabel(r.bridges[i].first),
+                                              m_dataHandler->nodeLabel(r.bridges[i].second));
+        if (r.bridges.size() > 20) lines << QString("  … %1 more").arg(r.bridges.size() - 20);
+        lines << "";
+    }
+    if (cuts.isEmpty() && r.bridges.isEmpty())
+        lines << "No single node or edge failure disconnects the graph.";
+    else
+        lines << QString("Highlighted %1 node(s) and %2 edge(s) in the graph.").arg(cutNodes.size()).arg(bridgeEdges.size());
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Minimum spanning forest
+// ---------------------------------------------------------------
+bool AlgorithmPanel::askMstParams(MstParams& out) {
+    out = m_mstParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Spanning Forest Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(
+        "Lightest set of edges that keeps every component connected, weights come from numeric edge labels.\n"
+        "Showing only the forest hides every other edge, a sparse backbone for dense graphs.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* methodCombo = new QComboBox;
+    methodCombo->addItem(QString("Auto (Borůvka from %1 edges)").arg(MST_BORUVKA_EDGES), int(MstMethod::Auto));
+    methodCombo->addItem("Kruskal", int(MstMethod::Kruskal));
+    methodCombo->addItem("Borůvka", int(MstMethod::Boruvka));
+    methodCombo->setCurrentIndex(methodCombo->findData(int(out.method)));
+    form->addRow("Method:", methodCombo);
+
+    auto* backboneChk = new QCheckBox("Show only spanning forest edges");
+    backboneChk->setChecked(out.showBackboneOnly);
+    form->addRow("", backboneChk);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.method = MstMethod(methodCombo->currentData().toInt());
+    out.showBackboneOnly = backboneChk->isChecked();
+    m_mstParams = out;
+    return true;
+}
+
+// hide every visual edge that no forest edge maps onto, or show them all again.
+// returns the number of hidden edges
+int AlgorithmPanel::showSpanningBackbone(const SpanningForestResult& forest, bool backboneOnly)
+{
+    QSet<QPair<int,int>> keep;
+    if (backboneOnly) {
+        keep.reserve(forest.edges.size() * 2);
+        for (const QPair<int,int>& e : forest.edges) {
+            const int fu = m_netSimWindow->backIdToFrontId(e.first);
+            const int fv = m_netSimWindow->backIdToFrontId(e.second);
+            keep.insert(qMakePair(fu, fv));
+            keep.insert(qMakePair(fv, fu));
+        }
+    }
+
+    // undirected edges sit in the hash under both keys, count each item once
+    QSet<NetworkEdge*> hidden;
+    for (auto it = m_edgeItems->cbegin(); it != m_edgeItems->cend(); ++it) {
+        const bool visible = !backboneOnly || keep.contains(it.key());
+        it.value()->setVisible(visible);
+        if (!visible) hidden.insert(it.value());
+    }
+    return hidden.size();
+}
+
+QString AlgorithmPanel::algoSpanningForest(const MstParams& params)
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const SpanningForestResult r = minimumSpanningForest(g, params.method);
+    const qint64 ns = timer.nsecsElapsed();
+
+    const int hidden = showSpanningBackbone(r, params.showBackboneOnly);
+
+    QStringList lines;
+    lines << QString("\nTime: %1").arg(formatNsecs(ns));
+    lines << QString("Method: %1").arg(r.method == MstMethod::Kruskal
+                                           ? QString("Kruskal (parallel sort, union-find)")
+                                           : QString("Borůvka, %1 round(s) on %2 thread(s)")
+                                                 .arg(r.rounds).arg(parallelWorkers(g.nodeCount / 1024 + 1)));
+    lines << QString("Forest edges: %1 in %2 tree(s)").arg(r.edges.size()).arg(r.trees);
+    lines << QString("Total weight: %1").arg(r.totalWeight);
+    if (!g.allNumeric)
+        lines << "Some edge labels are not numeric and count as weight 1.";
+    if (m_netSimWindow->directedEdges)
+        lines << "Edge direction is ignored, antiparallel edges keep the lighter weight.";
+    lines << "";
+
+    if (params.showBackboneOnly)
+        lines << QString("Hid %1 non-forest edge(s), run again without the backbone option to show them.").arg(hidden);
+
+    // heaviest forest edges, the weakest links of the backbone
+    QVector<int> order(r.edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&r](int a, int b) { return r.weights[a] > r.weights[b]; });
+    if (!order.isEmpty()) {
+        lines << "Heaviest forest edges:";
+        for (int i = 0; i < qMin(10, order.size()); ++i) {
+            const QPair<int,int>& e = r.edges[order[i]];
+            lines << QString("  %1 – %2  (%3)").arg(m_dataHandler->nodeLabel(e.first),
+                                                    m_dataHandler->nodeLabel(e.second))
+                                               .arg(r.weights[order[i]]);
+        }
+    }
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Maximum flow / minimum cut
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoMaxFlow(int sourceId, int targetId)
+{
+    if (sourceId == -1 || !m_dataHandler->nodeExists(sourceId)) return "No source node.";
+    if (targetId == -1 || !m_dataHandler->nodeExists(targetId)) return "No target node.";
+    if (sourceId == targetId) return "Source and target must differ.";
+
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const MaxFlowResult r = maxFlowMinCut(g, sourceId, targetId);
+    const qint64 ns = timer.nsecsElapsed();
+
+    // highlight the terminals and the cut edges
+    QHash<int, NetworkNode*> terminals;
+    for (int id : { sourceId, targetId }) {
+        const int frontId = m_netSimWindow->backIdToFrontId(id);
+        if (NetworkNode* node = m_nodeItems->value(frontId)) terminals.insert(frontId, node);
+    }
+    QHash<QPair<int,int>, NetworkEdge*> cutEdges;
+    for (const QPair<int,int>& e : r.cutEdges) {
+        const int fu = m_netSimWindow->backIdToFrontId(e.first);
+        const int fv = m_netSimWindow->backIdToFrontId(e.second);
+        if (fu == fv) continue;
+        NetworkEdge* edge = m_edgeItems->value(qMakePair(fu, fv), m_edgeItems->value(qMakePair(fv, fu)));
+        if (edge) cutEdges.insert(qMakePair(fu, fv), edge);
+    }
+    emit requestHighlightNodes(terminals);
+    emit requestHighlightEdges(cutEdges);
+
+    int sourceSide = 0;
+    for (bool side : r.sourceSide) sourceSide += side;
+
+    QStringList lines;
+    lines << QString("\nTime: %1").arg(formatNsecs(ns));
+    lines << QString("Source: %1   Target: %2").arg(m_dataHandler->nodeLabel(sourceId),
+                                                   m_dataHandler->nodeLabel(targetId));
+    if (!g.allNumeric) lines << "Some edge labels are not numeric and count as capacity 1.";
+    if (g.hasNegative) lines << "Negative capacities count as 0.";
+    lines << "";
+    lines << QString("Maximum flow: %1").arg(r.value);
+    lines << QString("Minimum cut: %1 edge(s), %2 node(s) on the source side")
+             .arg(r.cutEdges.size()).arg(sourceSide);
+    lines << QString("Pushes: %1   Relabels: %2   Global relabels: %3   Gap lifted: %4")
+             .arg(r.pushes).arg(r.relabels).arg(r.globalRelabels).arg(r.gapNodes);
+
+    if (r.value == 0.0) {
+        lines << "" << "Target is not reachable from the source through positive capacity.";
+        return lines.join("\n");
+    }
+
+    lines << "" << "Cut edges (capacity):";
+    for (int i = 0; i < qMin(30, r.cutEdges.size()); ++i)
+        lines << QString("  %1 -> %2  (%3)").arg(m_dataHandler->nodeLabel(r.cutEdges[i].first),
+                                                  m_dataHandler->nodeLabel(r.cutEdges[i].second))
+                                             .arg(r.cutCapacities[i]);
+    if (r.cutEdges.size() > 30) lines << QString("  … %1 more").arg(r.cutEdges.size() - 30);
+    lines << "" << QString("Highlighted %1 cut edge(s) in the graph.").arg(cutEdges.size());
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Diameter, radius and eccentricities
+// ---------------------------------------------------------------
+QString AlgorithmPanel::algoDiameter()
+{
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const DiameterResult d = ifubDiameter(g);
+    const qint64 ifubNs = timer.nsecsElapsed();
+    if (d.componentSize == 0) return "Graph is empty.";
+
+    timer.restart();
+    const EccentricityResult e = eccentricityBounds(g);
+    const qint64 boundsNs = timer.nsecsElapsed();
+    Q_ASSERT(e.diameter == d.diameter);
+
+    QVector<double> column(g.nodeCount, NAN);
+    int resolved = 0;
+    for (int v = 0; v < g.nodeCount; ++v) {
+        if (e.eccentricity[v] < 0) continue;
+        column[v] = e.eccentricity[v];
+        ++resolved;
+    }
+    publishNodeMetric("Eccentricity", column);
+
+    auto labelList = [this](const QVector<int>& ids) {
+        QStringList labels;
+        for (int i = 0; i < qMin(15, ids.size()); ++i) labels << m_dataHandler->nodeLabel(ids[i]);
+        if (ids.size() > 15) labels << QString("… %1 more").arg(ids.size() - 15);
+        return labels.join(", ");
+    };
+
+    QStringList lines;
+    lines << QString("\niFUB                : %1, %2 BFS run(s)").arg(formatNsecs(ifubNs)).arg(d.bfsRuns);
+    lines << QString("Eccentricity bounds : %1, %2 BFS run(s)").arg(formatNsecs(boundsNs)).arg(e.bfsRuns);
+    lines << QString("Largest component: %1 of %2 node(s)").arg(d.componentSize).arg(m_dataHandler->nodeCount());
+    if (m_netSimWindow->directedEdges)
+        lines << "Edge direction is ignored, distances are hops in the undirected view.";
+    lines << "";
+
+    lines << QString("Diameter: %1  (4-sweep lower bound %2)").arg(d.diameter).arg(d.lowerBound);
+    if (d.diameter > 0)
+        lines << QString("  e.g. %1 to %2").arg(m_dataHandler->nodeLabel(d.from), m_dataHandler->nodeLabel(d.to));
+    lines << QString("Radius: %1").arg(e.radius);
+    lines << QString("Centre (%1): %2").arg(e.centre.size()).arg(labelList(e.centre));
+    lines << QString("Periphery (%1): %2").arg(e.periphery.size()).arg(labelList(e.periphery));
+    lines << "";
+    lines << QString("Written to the node table column \"Eccentricity\", %1 of %2 node(s) resolved exactly,")
+             .arg(resolved).arg(d.componentSize);
+    lines << "the rest were pruned as neither central nor peripheral.";
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// HyperANF distance distribution
+// ---------------------------------------------------------------
+bool AlgorithmPanel::askHyperAnfParams(HyperAnfParams& out) {
+    out = m_hyperAnfParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("HyperANF Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(
+        "Estimates how many node pairs lie within each hop distance with HyperLogLog counters.\n"
+        "More registers lower the error (1.04 / sqrt(registers)) but cost registers bytes per node, twice.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* registersCombo = new QComboBox;
+    for (int b = 4; b <= 10; ++b)
+        registersCombo->addItem(QString("%1 (±%2%)").arg(1 << b).arg(104.0 / std::sqrt(double(1 << b)), 0, 'f', 1), b);
+    registersCombo->setCurrentIndex(registersCombo->findData(out.log2Registers));
+    form->addRow("Registers:", registersCombo);
+
+    auto* iterSpin = new QSpinBox;
+    iterSpin->setRange(1, 1000);
+    iterSpin->setValue(out.maxIterations);
+    form->addRow("Max passes:", iterSpin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.log2Registers = registersCombo->currentData().toInt();
+    out.maxIterations = iterSpin->value();
+    m_hyperAnfParams = out;
+    return true;
+}
+
+QString AlgorithmPanel::algoHyperAnf(const HyperAnfParams& params)
+{
+    if (m_dataHandler->nodeCount() == 0) return "Graph is empty.";
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    const NeighbourhoodFunction nf = hyperAnf(g, params.log2Registers, params.maxIterations);
+    const qint64 ns = timer.nsecsElapsed();
+
+    const int passes = nf.pairs.size() - 1 + (nf.converged ? 1 : 0);
+    QStringList lines;
+    lines << QString("\nTime: %1, %2 pass(es) on %3 thread(s)")
+             .arg(formatNsecs(ns)).arg(passes).arg(parallelWorkers(g.nodeCount / 256 + 1));
+    lines << QString("Registers per node: %1 (counter error ±%2%)")
+             .arg(nf.registers).arg(nf.relativeError * 100.0, 0, 'f', 1);
+    if (!nf.converged)
+        lines << QString("Stopped after %1 passes before every counter settled, tail distances are missing.")
+                 .arg(params.maxIterations);
+
+    const double reachable = nf.pairs.last() - nf.pairs.first();
+    if (reachable <= 0.0) {
+        lines << "" << "No node reaches another node.";
+        return lines.join("\n");
+    }
+    lines << QString("Reachable pairs    : ~%1").arg(reachable, 0, 'f', 0);
+    lines << QString("Average distance   : %1").arg(nf.averageDistance, 0, 'f', 3);
+    lines << QString("Effective diameter : %1 (90th percentile)").arg(nf.effectiveDiameter, 0, 'f', 2);
+    lines << "";
+
+    // share of reachable pairs at each distance, bars scaled to the most common one
+    const int BAR_WIDTH = 40;
+    double peak = 0.0;
+    for (int t = 1; t < nf.pairs.size(); ++t)
+        peak = qMax(peak, nf.pairs[t] - nf.pairs[t - 1]);
+
+    lines << "Hops   Pairs %   Cumul %";
+    for (int t = 1; t < nf.pairs.size(); ++t) {
+        const double share = (nf.pairs[t] - nf.pairs[t - 1]) / reachable;
+        const double cumulative = (nf.pairs[t] - nf.pairs.first()) / reachable;
+        const int bar = peak > 0.0 ? qRound(BAR_WIDTH * (nf.pairs[t] - nf.pairs[t - 1]) / peak) : 0;
+        lines << QString("%1  %2  %3  %4")
+                 .arg(t, 4)
+                 .arg(share * 100.0, 8, 'f', 2)
+                 .arg(cumulative * 100.0, 8, 'f', 2)
+                 .arg(QString(bar, QChar(0x2588)));
+    }
+
+    return lines.join("\n");
+}
+
+// ---------------------------------------------------------------
+// Louvain communities
+// ---------------------------------------------------------------
+bool AlgorithmPanel::askLouvainParams(LouvainParams& out) {
+    out = m_louvainParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Communities Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(
+        "Groups nodes into densely linked communities by maximising modularity (Louvain).\n"
+        "Higher resolution gives more, smaller communities.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* resolutionSpin = new QDoubleSpinBox;
+    resolutionSpin->setRange(0.05, 10.0);
+    resolutionSpin->setDecimals(2);
+    resolutionSpin->setSingleStep(0.1);
+    resolutionSpin->setValue(out.resolution);
+    form->addRow("Resolution:", resolutionSpin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.resolution = resolutionSpin->value();
+    m_louvainParams = out;
+    return true;
+}
+
+QString AlgorithmPanel::algoCommunities(const LouvainParams& params)
+{
+    if (m_dataHandler->nodeCount() == 0) return "Graph is empty.";
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    m_communities = louvainCommunities(g, params.resolution);
+    m_communitiesRevision = m_dataHandler->revision();
+    m_communitiesFromLabels = false;
+    const qint64 ns = timer.nsecsElapsed();
+    const CommunityResult& r = m_communities;
+
+    QStringList levels;
+    for (double q : r.levelModularity) levels << QString::number(q, 'f', 4);
+
+    QStringList lines;
+    lines << QString("\nTime: %1 on %2 thread(s)").arg(formatNsecs(ns)).arg(parallelWorkers(g.nodeCount / 512 + 1));
+    lines << QString("Levels: %1  (modularity per level: %2)").arg(r.levels).arg(levels.join(" -> "));
+    lines << describeCommunities(r);
+    return lines.join("\n");
+}
+
+QString AlgorithmPanel::algoLabelPropagation(const LabelPropagationParams& params)
+{
+    if (m_dataHandler->nodeCount() == 0) return "Graph is empty.";
+    const CsrGraph g = CsrGraph::fromDataHandler(*m_dataHandler);
+
+    QElapsedTimer timer;
+    timer.start();
+    m_communities = labelPropagation(g, params.maxSweeps);
+    m_communitiesRevision = m_dataHandler->revision();
+    m_communitiesFromLabels = true;
+    const qint64 ns = timer.nsecsElapsed();
+    const CommunityResult& r = m_communities;
+
+    QStringList lines;
+    lines << QString("\nTime: %1 on %2 thread(s)").arg(formatNsecs(ns)).arg(parallelWorkers(g.nodeCount / 1024 + 1));
+    lines << (r.converged ? QString("Converged after %1 sweep(s).").arg(r.sweeps)
+                          : QString("Stopped after %1 sweep(s), labels were still changing.").arg(r.sweeps));
+    lines << describeCommunities(r);
+    return lines.join("\n");
+}
+
+// community column, colouring and the largest groups, shared by Louvain and label propagation
+QStringList AlgorithmPanel::describeCommunities(const CommunityResult& r)
+{
+    const int N = r.community.size();
+    QVector<double> column(N, NAN);
+    QVector<QStringList> members(r.count);
+    for (int v = 0; v < N; ++v) {
+        if (r.community[v] == -1) continue;
+        column[v] = r.community[v] + 1;
+        if (members[r.community[v]].size() <= 8) members[r.community[v]] << m_dataHandler->nodeLabel(v);
+    }
+    publishNodeMetric("Community", column);
+
+    int singletons = 0;
+    for (int size : r.sizes) singletons += size == 1;
+
+    QStringList lines;
+    lines << QString("Communities: %1 (%2 single node)").arg(r.count).arg(singletons);
+    lines << QString("Modularity: %1").arg(r.modularity, 0, 'f', 4);
+    lines << "Written to the node table column \"Community\", contract them from the Visuals page." << "";
+
+    lines << "Largest communities:";
+    for (int c = 0; c < qMin(15, r.count); ++c) {
+        QStringList labels = members[c].mid(0, 8);
+        if (r.sizes[c] > 8) labels << "…";
+        lines << QString("  [%1]  %2 node(s)  { %3 }").arg(c + 1).arg(r.sizes[c]).arg(labels.join(", "));
+    }
+    if (r.count > 15) lines << QString("  … %1 more").arg(r.count - 15);
+    return lines;
+}
+
+bool AlgorithmPanel::askLabelPropagationParams(LabelPropagationParams& out) {
+    out = m_labelPropagationParams;
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Label Propagation Parameters");
+    dlg.setMinimumWidth(320);
+
+    auto* form   = new QFormLayout;
+    auto* layout = new QVBoxLayout(&dlg);
+
+    auto* descLbl = new QLabel(
+        "Every node repeatedly takes the most common label among its neighbours.\n"
+        "Near linear time, a quick first grouping when Louvain is too slow.");
+    descLbl->setWordWrap(true);
+    descLbl->setStyleSheet("color: #4a5a7a; font-size: 10px; padding-bottom: 6px;");
+    layout->addWidget(descLbl);
+    layout->addLayout(form);
+
+    auto* sweepsSpin = new QSpinBox;
+    sweepsSpin->setRange(1, 1000);
+    sweepsSpin->setValue(out.maxSweeps);
+    form->addRow("Max sweeps:", sweepsSpin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return false;
+
+    out.maxSweeps = sweepsSpin->value();
+    m_labelPropagationParams = out;
+    return true;
+}
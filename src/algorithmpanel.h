@@ -21,6 +21,7 @@
 #include <QComboBox>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
 #include <QFormLayout>
 #include <QQueue>
 #include <QStack>
@@ -29,6 +30,7 @@
 #include <functional>
 #include <limits>
 #include <algorithm>
+#include <numeric>
 #include <cmath>
 #include <climits>
 #include <cstdlib>
@@ -37,6 +39,8 @@
 #include <QGraphicsScene>
 #include <QGraphicsRectItem>
 #include "datahandler.h"
+#include "graphengine.h"
+#include "contractionhierarchy.h"
 #include "netsim_classes.h"
 
 class NetworkNode;
@@ -74,6 +78,63 @@ struct SpiralParams {
     qreal radiusGrowth = 50.0;
 };
 
+// A* heuristic scale, minimum edge cost per pixel of layout distance
+struct AStarParams {
+    double costPerUnit = 0.01;
+};
+
+// ALT landmark preprocessing params
+struct AltParams {
+    int landmarks = 8;
+    LandmarkStrategy strategy = LandmarkStrategy::FarthestPoint;
+};
+
+// betweenness params, 0 samples runs every source
+struct BetweennessParams {
+    int samples = 0;
+    bool weighted = false;
+};
+
+// power iteration params shared by PageRank and eigenvector centrality
+struct PageRankParams {
+    double damping = 0.85;
+    double tolerance = 1e-6;
+    int maxIterations = 100;
+    bool personaliseSelection = false;  // teleport only to the selected nodes
+};
+
+// spanning forest params, the backbone hides every non-tree edge in the scene
+struct MstParams {
+    MstMethod method = MstMethod::Auto;
+    bool showBackboneOnly = false;
+};
+
+// HyperANF counter size and pass limit
+struct HyperAnfParams {
+    int log2Registers = 6;
+    int maxIterations = 64;
+};
+
+// Louvain resolution, above 1 favours smaller communities
+struct LouvainParams {
+    double resolution = 1.0;
+};
+
+// label propagation sweep limit
+struct LabelPropagationParams {
+    int maxSweeps = 20;
+};
+
+// proximity contraction, cell size in screen pixels at the current zoom
+struct GridContractParams {
+    double cellPixels = 60.0;
+};
+
+// contract outside k-core params
+struct KCoreContractParams {
+    int k = 2;
+};
+
 // contract high degree params
 struct ContractHighDegreeParams {
     double percent = 10.0;
@@ -100,11 +161,24 @@ public:
 
     bool configureLayoutParams(const QString& algo); 
 
+    // positions indexed by backend id, contracted members take their node's position
+    QVector<QPointF> backendPositions(QVector<bool>& hasPos) const;
+
     // default params
     SFDPParams m_sfdpParams;
     CircularParams m_circularParams;
     SpiralParams m_spiralParams;
     ContractHighDegreeParams m_contractHighDegreeParams;
+    KCoreContractParams m_kCoreContractParams;
+    AStarParams m_astarParams;
+    AltParams m_altParams;
+    BetweennessParams m_betweennessParams;
+    PageRankParams m_pageRankParams;
+    MstParams m_mstParams;
+    HyperAnfParams m_hyperAnfParams;
+    LouvainParams m_louvainParams;
+    LabelPropagationParams m_labelPropagationParams;
+    GridContractParams m_gridContractParams;
 
 signals:
     void requestHighlightNodes(QHash<int, NetworkNode*>& nodes);
@@ -178,17 +252,70 @@ private:
     QString algoContractHighDegree(bool askUser = true);
     bool askContractHighDegreeParams(ContractHighDegreeParams& out);
 
+    QString algoContractOutsideKCore(bool askUser = true);
+    QString algoContractScc();
+    QString algoContractCommunities();
+    QString algoContractGrid(bool askUser = true);
+    bool askGridContractParams(GridContractParams& out);
+    bool askKCoreContractParams(KCoreContractParams& out, int degeneracy);
+
+    // shared by the contraction modes
+    QVector<QVector<int>> connectedGroups(const QSet<int>& toContractSet) const;
+    void applyContraction(const QVector<QVector<int>>& compMembers);
+
 
     QVector<double> m_sfdpAdjWeight;
     QHash<int,int> m_sfdpFrontIdtoIndex;
     QHash<int,int> m_sfdpIndexToFrontId;
+
+    // landmark oracle, rebuilt lazily when the DataHandler revision moves
+    AltOracle m_altOracle;
+
+    // contraction hierarchy, same revision check as the oracle
+    ContractionHierarchy m_ch;
+
+    // last community run (Louvain or label propagation), contraction reuses it while the revision matches
+    CommunityResult m_communities;
+    quint64 m_communitiesRevision = 0;
+    bool m_communitiesFromLabels = false;
     
 
     // ── Search / Analysis ──────────────────────────────────────
     QString algoBFS(int sourceId, int targetId);
     QString algoDFS(int sourceId, int targetId);
     QString algoDijkstra(int sourceId, int targetId);
+    QString algoAStar(int sourceId, int targetId, const AStarParams& params);
+    bool askAStarParams(AStarParams& out);
+    QString algoBuildAlt(const AltParams& params);
+    QString algoAlt(int sourceId, int targetId);
+    bool askAltParams(AltParams& out);
+    QString algoBuildCh();
+    QString algoCh(int sourceId, int targetId);
     QString algoConnectedComponents();
+    QString algoHopDistances();
+    QString algoBetweenness(const BetweennessParams& params);
+    bool askBetweennessParams(BetweennessParams& out);
+    void publishNodeMetric(const QString& name, const QVector<double>& values);
+    QString algoPageRank(const PageRankParams& params);
+    QString algoEigenvector(const PageRankParams& params);
+    bool askPageRankParams(PageRankParams& out, bool eigenvector);
+    QString algoTriangles();
+    QString algoKCore();
+    QString algoStronglyConnected();
+    QString algoArticulation();
+    QString algoSpanningForest(const MstParams& params);
+    QString algoMaxFlow(int sourceId, int targetId);
+    QString algoDiameter();
+    QString algoHyperAnf(const HyperAnfParams& params);
+    bool askHyperAnfParams(HyperAnfParams& out);
+    QString algoCommunities(const LouvainParams& params);
+    bool askLouvainParams(LouvainParams& out);
+    QString algoLabelPropagation(const LabelPropagationParams& params);
+    bool askLabelPropagationParams(LabelPropagationParams& out);
+    QStringList describeCommunities(const CommunityResult& r);
+    bool askMstParams(MstParams& out);
+    int showSpanningBackbone(const SpanningForestResult& forest, bool backboneOnly);
+    QString formatPowerIteration(const QString& metric, const PowerIterationResult& r, qint64 nsecs) const;
 
 
     // ── Helpers ────────────────────────────────────────────────
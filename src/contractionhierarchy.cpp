@@ -0,0 +1,394 @@
+#include "contractionhierarchy.h"
+#include <algorithm>
+#include <QElapsedTimer>
+
+namespace {
+
+// arc in the dynamic graph used while contracting
+struct ChArc {
+    int node;
+    double weight;
+    int middle;
+};
+
+enum class ArcChange { None, Improved, Appended };
+
+// add the arc or lower its weight, says which of the two happened
+ArcChange addOrImprove(QVector<ChArc>& list, int node, double weight, int middle)
+{
+    for (ChArc& a : list) {
+        if (a.node != node) continue;
+        if (weight >= a.weight) return ArcChange::None;
+        a.weight = weight;
+        a.middle = middle;
+        return ArcChange::Improved;
+    }
+    list.append({node, weight, middle});
+    return ArcChange::Appended;
+}
+
+void removeArc(QVector<ChArc>& list, int node)
+{
+    for (int i = 0; i < list.size(); ++i) {
+        if (list[i].node == node) {
+            list[i] = list.last();
+            list.removeLast();
+            return;
+        }
+    }
+}
+
+// bounded Dijkstra over the remaining graph used to look for witness paths
+class WitnessSearch {
+public:
+    static const int SETTLE_LIMIT = 500;
+
+    explicit WitnessSearch(int nodeCount)
+        : m_dist(nodeCount, std::numeric_limits<double>::infinity())
+    {
+        m_heap.reset(nodeCount);
+    }
+
+    // distances from source not passing through skip, exact up to maxDist
+    void run(const QVector<QVector<ChArc>>& out, int source, int skip, double maxDist)
+    {
+        for (int v : m_touched) m_dist[v] = std::numeric_limits<double>::infinity();
+        m_touched.clear();
+        m_heap.clear();
+
+        m_dist[source] = 0.0;
+        m_touched.append(source);
+        m_heap.push(source, 0.0);
+
+        int settled = 0;
+        while (!m_heap.isEmpty() && m_heap.minKey() <= maxDist && settled < SETTLE_LIMIT) {
+            const int u = m_heap.popMin();
+            ++settled;
+            for (const ChArc& a : out[u]) {
+                if (a.node == skip) continue;
+                const double alt = m_dist[u] + a.weight;
+                if (alt < m_dist[a.node]) {
+                    if (m_dist[a.node] == std::numeric_limits<double>::infinity())
+                        m_touched.append(a.node);
+                    m_dist[a.node] = alt;
+                    m_heap.push(a.node, alt);
+                }
+            }
+        }
+    }
+
+    double dist(int v) const { return m_dist[v]; }
+
+private:
+    QVector<double> m_dist;
+    QVector<int> m_touched;
+    IndexedMinHeap m_heap;
+};
+
+// shortcuts needed to contract v. when apply is set they are added to the graph
+// and only the new arcs are counted, a shortcut that lowers an existing arc is not
+int contractNode(QVector<QVector<ChArc>>& out, QVector<QVector<ChArc>>& in,
+                 int v, WitnessSearch& witness, bool apply)
+{
+    int shortcuts = 0;
+    const QVector<ChArc> incoming = in[v];
+    const QVector<ChArc> outgoing = out[v];
+
+    double maxOut = 0.0;
+    for (const ChArc& w : outgoing) maxOut = qMax(maxOut, w.weight);
+
+    for (const ChArc& u : incoming) {
+        witness.run(out, u.node, v, u.weight + maxOut);
+
+        for (const ChArc& w : outgoing) {
+            if (w.node == u.node) continue;
+            const double via = u.weight + w.weight;
+            if (witness.dist(w.node) <= via) continue;
+
+            if (!apply) {
+                ++shortcuts;
+                continue;
+            }
+            if (addOrImprove(out[u.node], w.node, via, v) == ArcChange::Appended) ++shortcuts;
+            addOrImprove(in[w.node], u.node, via, v);
+        }
+    }
+    return shortcuts;
+}
+
+// freeze one direction of the per-node upward arc lists into CSR form
+void packArcs(const QVector<QVector<ChArc>>& lists, QVector<int>& offsets, QVector<int>& targets,
+              QVector<double>& weights, QVector<int>& middles)
+{
+    const int N = lists.size();
+    offsets.resize(N + 1);
+    int total = 0;
+    for (int v = 0; v < N; ++v) {
+        offsets[v] = total;
+        total += lists[v].size();
+    }
+    offsets[N] = total;
+
+    targets.resize(total);
+    weights.resize(total);
+    middles.resize(total);
+    for (int v = 0; v < N; ++v) {
+        int slot = offsets[v];
+        for (const ChArc& a : lists[v]) {
+            targets[slot] = a.node;
+            weights[slot] = a.weight;
+            middles[slot] = a.middle;
+            ++slot;
+        }
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------
+// Preprocessing
+// ---------------------------------------------------------------
+
+void ContractionHierarchy::build(const CsrGraph& graph, quint64 revision)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+    const int N = graph.nodeCount;
+    m_nodeCount = N;
+    m_alive = graph.alive;
+    m_revision = revision;
+
+    // dynamic adjacency in both directions, self loops never help a shortest path
+    QVector<QVector<ChArc>> out(N), in(N);
+    for (int u = 0; u < N; ++u) {
+        if (!graph.alive[u]) continue;
+        for (int i = graph.offsets[u]; i < graph.offsets[u + 1]; ++i) {
+            const int v = graph.targets[i];
+            if (v == u || !graph.alive[v]) continue;
+            out[u].append({v, graph.weights[i], -1});
+            in[v].append({u, graph.weights[i], -1});
+            ++m_originalEdges;
+        }
+    }
+
+    WitnessSearch witness(N);
+    QVector<int> deletedNeighbours(N, 0);
+
+    // priority = edge difference + contracted neighbours, keeps the order spread out
+    auto priority = [&](int v) {
+        const int added = contractNode(out, in, v, witness, false);
+        return double(added - in[v].size() - out[v].size() + deletedNeighbours[v]);
+    };
+
+    IndexedMinHeap order;
+    order.reset(N);
+    for (int v = 0; v < N; ++v)
+        if (graph.alive[v]) order.push(v, priority(v));
+
+    QVector<QVector<ChArc>> upLists(N), downLists(N);
+    m_rank.fill(-1, N);
+    int nextRank = 0;
+
+    // lazy updates: a popped node is re-evaluated and pushed back if it got worse
+    while (!order.isEmpty()) {
+        const int v = order.popMin();
+        const double p = priority(v);
+        if (!order.isEmpty() && p > order.minKey()) {
+            order.push(v, p);
+            continue;
+        }
+
+        // every arc still attached goes to an uncontracted, so higher ranked, node
+        m_rank[v] = nextRank++;
+        upLists[v] = out[v];
+        downLists[v] = in[v];
+
+        m_shortcuts += contractNode(out, in, v, witness, true);
+
+        // detach v from the remaining graph
+        for (const ChArc& a : in[v]) {
+            removeArc(out[a.node], v);
+            ++deletedNeighbours[a.node];
+        }
+        for (const ChArc& a : out[v]) {
+            removeArc(in[a.node], v);
+            ++deletedNeighbours[a.node];
+        }
+        out[v].clear();
+        in[v].clear();
+    }
+
+    packArcs(upLists, m_up.offsets, m_up.targets, m_up.weights, m_up.middles);
+    packArcs(downLists, m_down.offsets, m_down.targets, m_down.weights, m_down.middles);
+
+    // query scratch
+    const double INF = std::numeric_limits<double>::infinity();
+    m_fwdDist.fill(INF, N);
+    m_bwdDist.fill(INF, N);
+    m_fwdParent.fill(-1, N);
+    m_bwdParent.fill(-1, N);
+    m_fwdMiddle.fill(-1, N);
+    m_bwdMiddle.fill(-1, N);
+    m_fwdHeap.reset(N);
+    m_bwdHeap.reset(N);
+
+    m_built = true;
+    m_buildNs = timer.nsecsElapsed();
+}
+
+void ContractionHierarchy::clear()
+{
+    m_nodeCount = 0;
+    m_rank.clear();
+    m_alive.clear();
+    m_up = ArcList();
+    m_down = ArcList();
+    m_built = false;
+    m_originalEdges = 0;
+    m_shortcuts = 0;
+    m_buildNs = 0;
+    m_queryCount = 0;
+    m_queryNs = 0;
+    m_touched.clear();
+}
+
+// ---------------------------------------------------------------
+// Query
+// ---------------------------------------------------------------
+
+ContractionHierarchy::QueryResult ContractionHierarchy::query(int source, int target)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QueryResult r;
+    const double INF = std::numeric_limits<double>::infinity();
+    if (!m_built || source < 0 || target < 0 || source >= m_nodeCount || target >= m_nodeCount
+        || !m_alive[source] || !m_alive[target])
+        return r;
+
+    // reset what the previous query touched
+    for (int v : m_touched) {
+        m_fwdDist[v] = m_bwdDist[v] = INF;
+        m_fwdParent[v] = m_bwdParent[v] = -1;
+    }
+    m_touched.clear();
+    m_fwdHeap.clear();
+    m_bwdHeap.clear();
+
+    m_fwdDist[source] = 0.0;
+    m_bwdDist[target] = 0.0;
+    m_touched << source << target;
+    m_fwdHeap.push(source, 0.0);
+    m_bwdHeap.push(target, 0.0);
+
+    double best = INF;
+    int meet = -1;
+
+    // settle one node in one direction and relax its upward arcs
+    auto step = [&](IndexedMinHeap& heap, const ArcList& arcs, QVector<double>& dist,
+                    QVector<int>& parent, QVector<int>& middle, const QVector<double>& other) {
+        const int u = heap.popMin();
+        ++r.settled;
+        if (other[u] != INF && dist[u] + other[u] < best) {
+            best = dist[u] + other[u];
+            meet = u;
+        }
+        for (int i = arcs.offsets[u]; i < arcs.offsets[u + 1]; ++i) {
+            const int v = arcs.targets[i];
+            const double alt = dist[u] + arcs.weights[i];
+            if (alt < dist[v]) {
+                if (dist[v] == INF && other[v] == INF) m_touched.append(v);
+                dist[v] = alt;
+                parent[v] = u;
+                middle[v] = arcs.middles[i];
+                heap.push(v, alt);
+            }
+        }
+    };
+
+    // each direction stops once its smallest key cannot improve the best meeting point
+    while (true) {
+        const bool fwdOpen = !m_fwdHeap.isEmpty() && m_fwdHeap.minKey() < best;
+        const bool bwdOpen = !m_bwdHeap.isEmpty() && m_bwdHeap.minKey() < best;
+        if (!fwdOpen && !bwdOpen) break;
+
+        if (fwdOpen && (!bwdOpen || m_fwdHeap.minKey() <= m_bwdHeap.minKey()))
+            step(m_fwdHeap, m_up, m_fwdDist, m_fwdParent, m_fwdMiddle, m_bwdDist);
+        else
+            step(m_bwdHeap, m_down, m_bwdDist, m_bwdParent, m_bwdMiddle, m_fwdDist);
+    }
+
+    if (meet != -1) {
+        r.distance = best;
+
+        // source ... meet, walking the forward parents backwards
+        QVector<int> upChain;
+        for (int v = meet; v != -1; v = m_fwdParent[v]) upChain.append(v);
+        std::reverse(upChain.begin(), upChain.end());
+
+        r.path.append(source);
+        for (int i = 1; i < upChain.size(); ++i)
+            unpackArc(upChain[i - 1], upChain[i], m_fwdMiddle[upChain[i]], r.path);
+
+        // meet ... target, backward parents point towards the target
+        for (int v = meet; m_bwdParent[v] != -1; v = m_bwdParent[v])
+            unpackArc(v, m_bwdParent[v], m_bwdMiddle[v], r.path);
+    }
+
+    ++m_queryCount;
+    m_queryNs += timer.nsecsElapsed();
+    return r;
+}
+
+qint64 ContractionHierarchy::benchmark(const QVector<QPair<int,int>>& pairs)
+{
+    if (!m_built || pairs.isEmpty()) return 0;
+
+    const int queryCount = m_queryCount;
+    const qint64 queryNs = m_queryNs;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const auto& pair : pairs)
+        query(pair.first, pair.second);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    m_queryCount = queryCount;
+    m_queryNs = queryNs;
+    return elapsed / pairs.size();
+}
+
+// middle node of the stored arc from -> to, the lower ranked end holds it
+int ContractionHierarchy::arcMiddle(int from, int to) const
+{
+    const bool upward = m_rank[to] > m_rank[from];
+    const ArcList& arcs = upward ? m_up : m_down;
+    const int owner = upward ? from : to;
+    const int other = upward ? to : from;
+    for (int i = arcs.offsets[owner]; i < arcs.offsets[owner + 1]; ++i)
+        if (arcs.targets[i] == other) return arcs.middles[i];
+    return -1;
+}
+
+// append the original nodes of arc from -> to (excluding from) to path
+void ContractionHierarchy::unpackArc(int from, int to, int middle, QVector<int>& path) const
+{
+    // explicit stack, shortcut chains can be deep on long paths
+    struct Pending { int from, to, middle; };
+    QVector<Pending> stack;
+    stack.append({from, to, middle});
+
+    while (!stack.isEmpty()) {
+        const Pending cur = stack.takeLast();
+        if (cur.middle == -1) {
+            path.append(cur.to);
+            continue;
+        }
+        // second half is pushed first so the first half is emitted first
+        stack.append({cur.middle, cur.to, arcMiddle(cur.middle, cur.to)});
+        stack.append({cur.from, cur.middle, arcMiddle(cur.from, cur.middle)});
+    }
+}
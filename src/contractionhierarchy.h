@@ -0,0 +1,78 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <QVector>
+#include <QPair>
+#include <limits>
+#include "graphengine.h"
+
+// ---------------------------------------------------------------
+// ContractionHierarchy
+// ---------------------------------------------------------------
+
+// routing preprocessor: nodes are contracted one at a time in order of edge
+// difference, adding a shortcut u->w through v whenever a local witness search
+// cannot find a path u->w without v that is at least as short. queries are a
+// bidirectional Dijkstra that only climbs towards higher ranked nodes
+class ContractionHierarchy {
+public:
+    struct QueryResult {
+        double distance = std::numeric_limits<double>::infinity();
+        QVector<int> path;  // unpacked to original edges, empty if unreachable
+        int settled = 0;    // nodes settled by both search directions
+    };
+
+    // contracts every alive node of the snapshot, edge weights must be >= 0
+    void build(const CsrGraph& graph, quint64 revision);
+    void clear();
+
+    bool isBuilt() const { return m_built; }
+    bool isValid(quint64 revision) const { return m_built && m_revision == revision; }
+
+    QueryResult query(int source, int target);
+
+    // average query time over the given s-t pairs in nanoseconds, the
+    // running query stats are left untouched
+    qint64 benchmark(const QVector<QPair<int,int>>& pairs);
+
+    int originalEdges() const { return m_originalEdges; }
+    int shortcuts() const { return m_shortcuts; }
+    qint64 buildNsecs() const { return m_buildNs; }
+    int queryCount() const { return m_queryCount; }
+    qint64 averageQueryNsecs() const { return m_queryCount ? m_queryNs / m_queryCount : 0; }
+
+private:
+    // upward arcs in CSR form, middle is the contracted node a shortcut skips (-1 if original)
+    struct ArcList {
+        QVector<int> offsets;
+        QVector<int> targets;
+        QVector<double> weights;
+        QVector<int> middles;
+    };
+
+    int m_nodeCount = 0;
+    QVector<int> m_rank;      // contraction order, higher = more important
+    QVector<bool> m_alive;
+    ArcList m_up;             // arcs v->w with rank[w] > rank[v], searched from the source
+    ArcList m_down;           // arcs u->v with rank[u] > rank[v], stored at v, searched from the target
+
+    quint64 m_revision = 0;
+    bool m_built = false;
+    int m_originalEdges = 0;
+    int m_shortcuts = 0;
+    qint64 m_buildNs = 0;
+    int m_queryCount = 0;
+    qint64 m_queryNs = 0;
+
+    // query scratch, only the touched entries are reset between queries
+    QVector<double> m_fwdDist, m_bwdDist;
+    QVector<int> m_fwdParent, m_bwdParent;
+    QVector<int> m_fwdMiddle, m_bwdMiddle;
+    QVector<int> m_touched;
+    IndexedMinHeap m_fwdHeap, m_bwdHeap;
+
+    int arcMiddle(int from, int to) const;
+    void unpackArc(int from, int to, int middle, QVector<int>& path) const;
+};
+
+#endif // CONTRACTIONHIERARCHY_H
@@ -1,6 +1,7 @@
 #include "datahandler.h"
 #include <algorithm>
 #include <QDebug>
+#include <cmath>
 
 DataHandler::DataHandler() {}
 DataHandler::~DataHandler() {}
@@ -25,6 +26,10 @@ int DataHandler::addNode(const QString& label, int initialCapacity) {
         info.edge_index = edges.size();
         nodes[id] = info;
         nodeLabels[id] = label;
+
+        // metrics computed for the old node do not apply to this one
+        for (auto& metric : nodeMetrics)
+            if (id < metric.second.size()) metric.second[id] = NAN;
     } 
     // otherwise add a new node at the end of the list
     else {
@@ -37,6 +42,8 @@ int DataHandler::addNode(const QString& label, int initialCapacity) {
 
     // Extend edges vector to hold the capacity
     ensureCapacity(info.edge_index + info.capacity);
+    quotientGraph.nodeAdded(id);
+    ++revisionCounter;
     return id;
 }
 
@@ -51,24 +58,64 @@ void DataHandler::removeNode(int nodeId) {
         removeEdge(e.destination, nodeId);
     }
 
+    // incoming edges of a directed graph, only the quotient knows their sources
+    for (int src : quotientGraph.sourcesOf(nodeId))
+        removeEdge(src, nodeId);
+
     // Mark node as inactive and recycle its ID
     nodes[nodeId].degree = -1;
     nodes[nodeId].edge_index = 0;
     nodes[nodeId].capacity = 0;
     nodeLabels[nodeId].clear();
     emptyNodeIds.push(nodeId);
+    quotientGraph.nodeRemoved(nodeId);
+    ++revisionCounter;
 }
 
-// removes a node without looping through to delete all of its edges
-void DataHandler::removeNodeNoEdges(int nodeId) {
-    if (nodeId < 0 || nodeId >= nodes.size() || nodes[nodeId].degree == -1) return;
-
-    // Mark node as inactive and recycle its ID
-    nodes[nodeId].degree = -1;
-    nodes[nodeId].edge_index = 0;
-    nodes[nodeId].capacity = 0;
-    nodeLabels[nodeId].clear();
-    emptyNodeIds.push(nodeId);
+// remove many nodes at once. instead of removing their edges pair by pair, every
+// edge list is filtered in one pass over the edge array
+void DataHandler::removeNodes(const QVector<int>& nodeIds) {
+    QVector<bool> dead(nodes.size(), false);
+    QVector<int> removed;
+    for (int id : nodeIds) {
+        if (!nodeExists(id) || dead[id]) continue;
+        dead[id] = true;
+        removed.append(id);
+    }
+    if (removed.isEmpty()) return;
+
+    // keep the arcs between surviving nodes, sliding them down within each block
+    QVector<QPair<int,int>> removedArcs;
+    for (int u = 0; u < nodes.size(); ++u) {
+        NodeInfo& info = nodes[u];
+        if (info.degree <= 0) continue;
+
+        const int begin = info.edge_index;
+        const int end = begin + info.degree;
+        int out = begin;
+        for (int i = begin; i < end; ++i) {
+            if (dead[u] || dead[edges[i].destination]) {
+                removedArcs.append(qMakePair(u, edges[i].destination));
+                continue;
+            }
+            if (out != i) edges[out] = std::move(edges[i]);
+            ++out;
+        }
+        totalEdges -= end - out;
+        info.degree = out - begin;
+    }
+    quotientGraph.arcsRemoved(removedArcs);
+
+    // Mark nodes as inactive and recycle their IDs
+    for (int id : removed) {
+        nodes[id].degree = -1;
+        nodes[id].edge_index = 0;
+        nodes[id].capacity = 0;
+        nodeLabels[id].clear();
+        emptyNodeIds.push(id);
+    }
+    quotientGraph.nodesRemoved(removed);
+    ++revisionCounter;
 }
 
 // set the label of a node using it id/index
@@ -105,6 +152,8 @@ void DataHandler::addEdge(int src, int dst, const QString& label) {
     edges[edge_position] = {dst, label};
     ++info.degree;
     ++totalEdges;
+    quotientGraph.arcAdded(src, dst);
+    ++revisionCounter;
 }
 
 // remove an edge from the data and subtract it from the node
@@ -123,6 +172,8 @@ void DataHandler::removeEdge(int src, int dst) {
         }
         --info.degree;
         --totalEdges;
+        quotientGraph.arcRemoved(src, dst);
+        ++revisionCounter;
 
         // shrink capacity if density is too low
         if (info.capacity > 4 && info.degree <= info.capacity / 4) {
@@ -169,6 +220,7 @@ void DataHandler::setEdgeLabel(int srcId, int dstId, const QString& label) {
     for (int i = node.edge_index; i < node.edge_index + node.degree; ++i) {
         if (edges[i].destination == dstId) {
             edges[i].label = label;
+            ++revisionCounter;
             return;
         }
     }
@@ -252,6 +304,51 @@ void DataHandler::clear() {
     nodeLabels.clear();
     totalEdges = 0;
     emptyNodeIds.clear();
+    nodeMetrics.clear();
+    quotientGraph.clear();
+    ++revisionCounter;
+}
+
+// ---------------------------------------------------------------
+// Node metrics
+// ---------------------------------------------------------------
+
+// store a metric column, replacing an existing one with the same name
+void DataHandler::setNodeMetric(const QString& name, const QVector<double>& values) {
+    for (auto& metric : nodeMetrics) {
+        if (metric.first == name) {
+            metric.second = values;
+            return;
+        }
+    }
+    nodeMetrics.append(qMakePair(name, values));
+}
+
+void DataHandler::removeNodeMetric(const QString& name) {
+    for (int i = 0; i < nodeMetrics.size(); ++i) {
+        if (nodeMetrics[i].first == name) {
+            nodeMetrics.remove(i);
+            return;
+        }
+    }
+}
+
+// metric names in the order they were first set
+QStringList DataHandler::nodeMetricNames() const {
+    QStringList names;
+    for (const auto& metric : nodeMetrics)
+        names << metric.first;
+    return names;
+}
+
+// value of a metric for one node, NaN if unknown
+double DataHandler::nodeMetric(const QString& name, int nodeId) const {
+    for (const auto& metric : nodeMetrics) {
+        if (metric.first != name) continue;
+        if (nodeId < 0 || nodeId >= metric.second.size()) return NAN;
+        return metric.second[nodeId];
+    }
+    return NAN;
 }
 
 // resize the edge array if we need more space
@@ -5,6 +5,8 @@
 #include <QString>
 #include <QPair>
 #include <QStack>
+#include <QStringList>
+#include "quotientgraph.h"
 
 // structure of the edge has is destination node and label
 struct EdgeInfo {
@@ -28,7 +30,7 @@ public:
     // Node operations
     int addNode(const QString& label, int initialCapacity = 4);
     void removeNode(int nodeId);
-    void removeNodeNoEdges(int nodeId);
+    void removeNodes(const QVector<int>& nodeIds);
     int nodeCount() const { return nodes.size() - emptyNodeIds.size(); }
     int nextNodeLabel() const { return nodes.size(); }
     QString nodeLabel(int nodeId) const { return nodeLabels.value(nodeId); }
@@ -49,12 +51,31 @@ public:
 
     void clear();
 
+    // bumped on every change to nodes, edges or edge labels, caches built
+    // from the adjacency compare against it to know when they are stale
+    quint64 revision() const { return revisionCounter; }
+
+    // per-node analysis results shown as extra node table columns. values are
+    // indexed by node id, missing or recycled ids read as NaN. setting a metric
+    // that already exists replaces it in place so its column keeps its position
+    void setNodeMetric(const QString& name, const QVector<double>& values);
+    void removeNodeMetric(const QString& name);
+    QStringList nodeMetricNames() const;
+    double nodeMetric(const QString& name, int nodeId) const;
+
+    // contraction groups over the nodes, kept in step with every node and edge change
+    QuotientGraph& quotient() { return quotientGraph; }
+    const QuotientGraph& quotient() const { return quotientGraph; }
+
 private:
     QVector<NodeInfo> nodes;
     QVector<EdgeInfo> edges;
     QVector<QString> nodeLabels;
     int totalEdges = 0;
     QStack<int> emptyNodeIds;
+    quint64 revisionCounter = 0;
+    QVector<QPair<QString, QVector<double>>> nodeMetrics;
+    QuotientGraph quotientGraph{this};
 
     // some helpers
     int findInsertPosition(int nodeId, int dst) const;
@@ -0,0 +1,72 @@
+#include "frontidmap.h"
+
+void FrontIdMap::setFront(int backId, int frontId)
+{
+    if (backId < 0) return;
+
+    // new ids start out mapped to themselves
+    if (backId >= m_front.size()) {
+        const int old = m_front.size();
+        m_front.resize(qMax(backId + 1, old * 2));
+        for (int i = old; i < m_front.size(); ++i) m_front[i] = i;
+    }
+    m_front[backId] = frontId;
+}
+
+FrontIdMap::Members FrontIdMap::members(int groupId) const
+{
+    const int s = slot(groupId);
+    if (s < 0 || m_count[s] == 0) return Members();
+
+    const int* base = m_members.constData() + m_start[s];
+    return { base, base + m_count[s] };
+}
+
+void FrontIdMap::setMembers(int groupId, const QVector<int>& members)
+{
+    if (groupId >= 0) return;
+
+    removeMembers(groupId);
+    const int s = -groupId - 1;
+    if (s >= m_start.size()) {
+        m_start.resize(s + 1);
+        m_count.resize(s + 1);
+    }
+    m_start[s] = m_members.size();
+    m_count[s] = members.size();
+    m_members += members;
+}
+
+void FrontIdMap::removeMembers(int groupId)
+{
+    const int s = slot(groupId);
+    if (s < 0 || m_count[s] == 0) return;
+
+    m_holes += m_count[s];
+    m_count[s] = 0;
+    if (m_holes > m_members.size() / 2) compact();
+}
+
+void FrontIdMap::clear()
+{
+    m_front.clear();
+    m_start.clear();
+    m_count.clear();
+    m_members.clear();
+    m_holes = 0;
+}
+
+// copy the live runs down in slot order, dropping the holes
+void FrontIdMap::compact()
+{
+    QVector<int> packed;
+    packed.reserve(m_members.size() - m_holes);
+    for (int s = 0; s < m_start.size(); ++s) {
+        if (m_count[s] == 0) continue;
+        const int* run = m_members.constData() + m_start[s];
+        m_start[s] = packed.size();
+        for (int i = 0; i < m_count[s]; ++i) packed.append(run[i]);
+    }
+    m_members = packed;
+    m_holes = 0;
+}
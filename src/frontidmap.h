@@ -0,0 +1,50 @@
+#ifndef FRONTIDMAP_H
+#define FRONTIDMAP_H
+
+#include <QVector>
+
+// ---------------------------------------------------------------
+// FrontIdMap
+// ---------------------------------------------------------------
+
+// translation between backend ids and the drawn (front) ids. the front id of every
+// backend id sits in a dense array, unmapped ids translate to themselves. members of
+// contracted nodes are kept CSR style: one flat member array with a start and count
+// per group slot, group g at -g - 1 like the quotient. replacing or removing a group's
+// members leaves a hole that is squeezed out once holes outweigh live members
+class FrontIdMap {
+public:
+    // view into the flat member array, invalidated by the next setMembers or removeMembers
+    struct Members {
+        const int* first = nullptr;
+        const int* last = nullptr;
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        int size() const { return int(last - first); }
+        bool isEmpty() const { return first == last; }
+        QVector<int> toVector() const { return QVector<int>(first, last); }
+    };
+
+    int frontOf(int backId) const { return backId >= 0 && backId < m_front.size() ? m_front[backId] : backId; }
+    void setFront(int backId, int frontId);
+    void resetFront(int backId) { if (backId >= 0 && backId < m_front.size()) m_front[backId] = backId; }
+
+    Members members(int groupId) const;
+    bool hasMembers(int groupId) const { return slot(groupId) >= 0 && m_count[slot(groupId)] > 0; }
+    void setMembers(int groupId, const QVector<int>& members);
+    void removeMembers(int groupId);
+
+    void clear();
+
+private:
+    QVector<int> m_front;       // per backend id
+    QVector<int> m_start;       // per group slot, offset into m_members
+    QVector<int> m_count;       // 0 when the slot holds no members
+    QVector<int> m_members;
+    int m_holes = 0;            // dead entries in m_members
+
+    int slot(int groupId) const { return groupId < 0 && -groupId - 1 < m_start.size() ? -groupId - 1 : -1; }
+    void compact();
+};
+
+#endif // FRONTIDMAP_H
@@ -0,0 +1,2289 @@
+#include "graphengine.h"
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <random>
+#include <cmath>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QHash>
+
+// ---------------------------------------------------------------
+// Parallel helper
+// ---------------------------------------------------------------
+
+int parallelWorkers(int count)
+{
+    return qBound(1, QThread::idealThreadCount(), qMax(count, 1));
+}
+
+// dynamic chunked loop, the calling thread works as worker 0
+void parallelFor(int count, int grain, const std::function<void(int begin, int end, int worker)>& body)
+{
+    if (count <= 0) return;
+    grain = qMax(grain, 1);
+    const int workers = parallelWorkers((count + grain - 1) / grain);
+
+    std::atomic<int> next(0);
+    auto run = [&](int worker) {
+        while (true) {
+            const int begin = next.fetch_add(grain);
+            if (begin >= count) break;
+            body(begin, qMin(begin + grain, count), worker);
+        }
+    };
+
+    QVector<std::thread*> threads;
+    for (int w = 1; w < workers; ++w)
+        threads.append(new std::thread(run, w));
+    run(0);
+    for (std::thread* t : threads) {
+        t->join();
+        delete t;
+    }
+}
+
+// ---------------------------------------------------------------
+// CsrGraph
+// ---------------------------------------------------------------
+
+// pack the backend edge blocks into one contiguous array, O(N + E)
+CsrGraph CsrGraph::fromDataHandler(const DataHandler& dataHandler)
+{
+    CsrGraph g;
+    const QVector<NodeInfo>* nodes = dataHandler.getAllNodes();
+    const QVector<EdgeInfo>* edges = dataHandler.getAllEdges();
+    const int N = nodes->size();
+
+    g.nodeCount = N;
+    g.offsets.resize(N + 1);
+    g.alive.resize(N);
+
+    // count edges first so the arrays are allocated once
+    int total = 0;
+    for (int u = 0; u < N; ++u) {
+        const NodeInfo& info = (*nodes)[u];
+        g.alive[u] = info.degree != -1;
+        g.offsets[u] = total;
+        if (info.degree > 0) total += info.degree;
+    }
+    g.offsets[N] = total;
+    g.targets.resize(total);
+    g.weights.resize(total);
+
+    // copy destinations and parse labels, same rule as Dijkstra: empty or non-numeric is 1
+    for (int u = 0; u < N; ++u) {
+        const NodeInfo& info = (*nodes)[u];
+        int out = g.offsets[u];
+        for (int i = info.edge_index; i < info.edge_index + info.degree; ++i, ++out) {
+            const EdgeInfo& e = (*edges)[i];
+            g.targets[out] = e.destination;
+
+            double w = 1.0;
+            if (!e.label.isEmpty()) {
+                bool ok = false;
+                double parsed = e.label.toDouble(&ok);
+                if (ok) w = parsed;
+                else g.allNumeric = false;
+            }
+            if (w < 0.0) g.hasNegative = true;
+            g.weights[out] = w;
+        }
+    }
+    return g;
+}
+
+// flip every edge with a counting pass over the targets, O(N + E)
+CsrGraph CsrGraph::reversed() const
+{
+    CsrGraph r;
+    r.nodeCount = nodeCount;
+    r.alive = alive;
+    r.allNumeric = allNumeric;
+    r.hasNegative = hasNegative;
+    r.offsets.fill(0, nodeCount + 1);
+    r.targets.resize(targets.size());
+    r.weights.resize(weights.size());
+
+    // in-degree counts shifted by one, then prefix sum into offsets
+    for (int v : targets) ++r.offsets[v + 1];
+    for (int u = 0; u < nodeCount; ++u) r.offsets[u + 1] += r.offsets[u];
+
+    // sources are visited in order so each reversed list stays sorted
+    QVector<int> fill = r.offsets;
+    for (int u = 0; u < nodeCount; ++u) {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            const int slot = fill[targets[i]]++;
+            r.targets[slot] = u;
+            r.weights[slot] = weights[i];
+        }
+    }
+    return r;
+}
+
+// merge the sorted out and in lists of each node, O(N + E)
+CsrGraph CsrGraph::symmetrized() const
+{
+    const CsrGraph in = reversed();
+
+    CsrGraph s;
+    s.nodeCount = nodeCount;
+    s.alive = alive;
+    s.allNumeric = allNumeric;
+    s.hasNegative = hasNegative;
+    s.offsets.fill(0, nodeCount + 1);
+    s.targets.reserve(targets.size() * 2);
+    s.weights.reserve(targets.size() * 2);
+
+    for (int u = 0; u < nodeCount; ++u) {
+        s.offsets[u] = s.targets.size();
+        if (!alive[u]) continue;
+
+        int i = offsets[u], j = in.offsets[u];
+        const int iEnd = offsets[u + 1], jEnd = in.offsets[u + 1];
+        int last = -1;
+        while (i < iEnd || j < jEnd) {
+            // take the smaller destination from either list
+            int v;
+            double w;
+            if (j >= jEnd || (i < iEnd && targets[i] <= in.targets[j])) { v = targets[i]; w = weights[i]; ++i; }
+            else { v = in.targets[j]; w = in.weights[j]; ++j; }
+
+            if (v == u || !alive[v]) continue;
+            if (v == last) { s.weights.last() = qMin(s.weights.last(), w); continue; }
+            s.targets.append(v);
+            s.weights.append(w);
+            last = v;
+        }
+    }
+    s.offsets[nodeCount] = s.targets.size();
+    return s;
+}
+
+// ---------------------------------------------------------------
+// IndexedMinHeap
+// ---------------------------------------------------------------
+
+// size the position index for node ids [0, nodeCount) and empty the heap
+void IndexedMinHeap::reset(int nodeCount)
+{
+    m_heap.clear();
+    m_heap.reserve(qMin(nodeCount, 1024));
+    m_pos.fill(-1, nodeCount);
+    m_key.resize(nodeCount);
+}
+
+// drop whatever is left without the O(N) refill of reset
+void IndexedMinHeap::clear()
+{
+    for (int node : m_heap)
+        m_pos[node] = -1;
+    m_heap.clear();
+}
+
+// insert, or move the node to its new key if it is already in the heap
+void IndexedMinHeap::push(int node, double key)
+{
+    int slot = m_pos[node];
+    if (slot == -1) {
+        slot = m_heap.size();
+        m_heap.append(node);
+        m_pos[node] = slot;
+        m_key[node] = key;
+        siftUp(slot);
+        return;
+    }
+
+    const double old = m_key[node];
+    m_key[node] = key;
+    if (key < old) siftUp(slot);
+    else siftDown(slot);
+}
+
+// remove and return the node with the smallest key
+int IndexedMinHeap::popMin()
+{
+    const int top = m_heap[0];
+    const int last = m_heap.last();
+    m_heap.removeLast();
+    m_pos[top] = -1;
+
+    // move the last node into the root and push it down
+    if (!m_heap.isEmpty()) {
+        m_heap[0] = last;
+        m_pos[last] = 0;
+        siftDown(0);
+    }
+    return top;
+}
+
+void IndexedMinHeap::siftUp(int slot)
+{
+    const int node = m_heap[slot];
+    const double key = m_key[node];
+
+    // shift parents down until the hole is where the node belongs
+    while (slot > 0) {
+        const int parent = (slot - 1) / 2;
+        const int parentNode = m_heap[parent];
+        if (m_key[parentNode] <= key) break;
+        m_heap[slot] = parentNode;
+        m_pos[parentNode] = slot;
+        slot = parent;
+    }
+    m_heap[slot] = node;
+    m_pos[node] = slot;
+}
+
+void IndexedMinHeap::siftDown(int slot)
+{
+    const int n = m_heap.size();
+    const int node = m_heap[slot];
+    const double key = m_key[node];
+
+    // shift the smaller child up until the node fits
+    while (true) {
+        int child = 2 * slot + 1;
+        if (child >= n) break;
+        if (child + 1 < n && m_key[m_heap[child + 1]] < m_key[m_heap[child]]) ++child;
+
+        const int childNode = m_heap[child];
+        if (key <= m_key[childNode]) break;
+        m_heap[slot] = childNode;
+        m_pos[childNode] = slot;
+        slot = child;
+    }
+    m_heap[slot] = node;
+    m_pos[node] = slot;
+}
+
+// ---------------------------------------------------------------
+// ShortestPathResult
+// ---------------------------------------------------------------
+
+// walk the predecessor chain back from target, empty if unreached
+QVector<int> ShortestPathResult::pathTo(int target) const
+{
+    QVector<int> path;
+    if (target < 0 || target >= dist.size() || dist[target] == std::numeric_limits<double>::infinity())
+        return path;
+
+    for (int cur = target; cur != -1; cur = prev[cur])
+        path.append(cur);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// ---------------------------------------------------------------
+// Bellman-Ford (SPFA)
+// ---------------------------------------------------------------
+
+ShortestPathResult spfaSearch(const CsrGraph& g, int source, int target)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    const int N = g.nodeCount;
+
+    ShortestPathResult r;
+    r.dist.fill(INF, N);
+    r.prev.fill(-1, N);
+    if (source < 0 || source >= N || !g.alive[source]) return r;
+
+    // the tree is kept as a preorder thread with depths, so a subtree is the run of
+    // nodes after its root that sit deeper than it
+    QVector<int> threadNext(N, -1), threadPrev(N, -1), depth(N, 0);
+    QVector<bool> inTree(N, false), queued(N, false);
+
+    // FIFO ring, each node is queued at most once at a time
+    QVector<int> ring(N);
+    int head = 0, size = 0;
+
+    r.dist[source] = 0.0;
+    inTree[source] = true;
+    ring[0] = source;
+    queued[source] = true;
+    size = 1;
+
+    while (size > 0) {
+        const int u = ring[head];
+        head = (head + 1) % N;
+        --size;
+        queued[u] = false;
+        if (!inTree[u]) continue;   // disassembled after it was queued, its label is stale
+        ++r.settled;
+
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (!g.alive[v]) continue;
+            const double nd = r.dist[u] + g.weights[i];
+            if (nd >= r.dist[v]) continue;
+
+            if (v == u) {
+                r.negativeCycle = { u };
+                return r;
+            }
+
+            // cut v's subtree out of the tree, meeting u in it means u->v closes a negative cycle
+            if (inTree[v]) {
+                int x = threadNext[v];
+                while (x != -1 && depth[x] > depth[v]) {
+                    if (x == u) {
+                        for (int c = u; c != v; c = r.prev[c])
+                            r.negativeCycle.append(c);
+                        r.negativeCycle.append(v);
+                        std::reverse(r.negativeCycle.begin(), r.negativeCycle.end());
+                        return r;
+                    }
+                    inTree[x] = false;
+                    x = threadNext[x];
+                }
+                const int p = threadPrev[v];
+                if (p != -1) threadNext[p] = x;
+                if (x != -1) threadPrev[x] = p;
+            }
+
+            // hang v under u, right after u in preorder
+            r.dist[v] = nd;
+            r.prev[v] = u;
+            inTree[v] = true;
+            depth[v] = depth[u] + 1;
+            threadPrev[v] = u;
+            threadNext[v] = threadNext[u];
+            if (threadNext[u] != -1) threadPrev[threadNext[u]] = v;
+            threadNext[u] = v;
+
+            if (!queued[v]) {
+                ring[(head + size) % N] = v;
+                ++size;
+                queued[v] = true;
+            }
+        }
+    }
+
+    r.reachedTarget = target >= 0 && target < N && r.dist[target] != INF;
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Multi-source BFS
+// ---------------------------------------------------------------
+
+QVector<HopStats> multiSourceHopStats(const CsrGraph& g, const QVector<int>& sources)
+{
+    QVector<HopStats> stats(sources.size());
+    const int batches = (sources.size() + MSBFS_WIDTH - 1) / MSBFS_WIDTH;
+    QVector<MsBfsScratch> scratch(parallelWorkers(batches));
+
+    // each batch writes its own slice of stats, no locking needed
+    parallelFor(batches, 1, [&](int begin, int end, int worker) {
+        for (int b = begin; b < end; ++b) {
+            const int first = b * MSBFS_WIDTH;
+            const int count = qMin(MSBFS_WIDTH, sources.size() - first);
+            HopStats* slice = stats.data() + first;
+
+            multiSourceBfs(g, sources.constData() + first, count, scratch[worker],
+                           [slice](int, quint64 mask, int depth) {
+                while (mask) {
+                    HopStats& h = slice[qCountTrailingZeroBits(mask)];
+                    h.distanceSum += depth;
+                    ++h.reached;
+                    h.eccentricity = qMax(h.eccentricity, depth);
+                    mask &= mask - 1;
+                }
+            });
+        }
+    });
+    return stats;
+}
+
+// ---------------------------------------------------------------
+// Diameter, radius and eccentricities
+// ---------------------------------------------------------------
+
+int bfsDistances(const CsrGraph& g, int source, QVector<int>& dist, QVector<int>& order)
+{
+    for (int v : order) dist[v] = -1;
+    order.clear();
+
+    dist[source] = 0;
+    order.append(source);
+    for (int qi = 0; qi < order.size(); ++qi) {
+        const int u = order[qi];
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (dist[v] != -1 || !g.alive[v]) continue;
+            dist[v] = dist[u] + 1;
+            order.append(v);
+        }
+    }
+    return dist[order.last()];
+}
+
+namespace {
+
+// a node of the largest connected component of a symmetric graph, -1 if empty
+int largestComponentNode(const CsrGraph& s, int* size)
+{
+    QVector<int> dist(s.nodeCount, -1), order;
+    QVector<bool> seen(s.nodeCount, false);
+    int best = -1;
+    *size = 0;
+    for (int v = 0; v < s.nodeCount; ++v) {
+        if (!s.alive[v] || seen[v]) continue;
+        bfsDistances(s, v, dist, order);
+        for (int w : order) seen[w] = true;
+        if (order.size() > *size) { *size = order.size(); best = v; }
+    }
+    return best;
+}
+
+// node halfway along a shortest path from the BFS source to target, walking parents through dist
+int bfsMidpoint(const CsrGraph& s, const QVector<int>& dist, int target)
+{
+    int cur = target;
+    const int half = dist[target] / 2;
+    while (dist[cur] > half) {
+        for (int i = s.offsets[cur]; i < s.offsets[cur + 1]; ++i) {
+            if (dist[s.targets[i]] == dist[cur] - 1) { cur = s.targets[i]; break; }
+        }
+    }
+    return cur;
+}
+
+} // namespace
+
+DiameterResult ifubDiameter(const CsrGraph& g)
+{
+    const CsrGraph s = g.symmetrized();
+    DiameterResult r;
+    const int start = largestComponentNode(s, &r.componentSize);
+    if (start == -1) return r;
+
+    QVector<int> dist(s.nodeCount, -1), order;
+    auto bfs = [&](int source) { ++r.bfsRuns; return bfsDistances(s, source, dist, order); };
+
+    // 4-sweep from the highest degree node of the component
+    int r1 = start;
+    bfs(start);
+    for (int v : order) if (s.degree(v) > s.degree(r1)) r1 = v;
+
+    int u = r1;
+    for (int sweep = 0; sweep < 2; ++sweep) {
+        bfs(u);
+        const int a = order.last();
+        const int eccA = bfs(a);
+        const int b = order.last();
+        if (eccA > r.lowerBound) { r.lowerBound = eccA; r.from = a; r.to = b; }
+        u = bfsMidpoint(s, dist, b);
+    }
+
+    // iFUB: fringe levels of u from the outside in
+    const int eccU = bfs(u);
+    QVector<int> levelOffsets(eccU + 2, 0);
+    for (int v : order) ++levelOffsets[dist[v] + 1];
+    for (int i = 0; i <= eccU; ++i) levelOffsets[i + 1] += levelOffsets[i];
+    const QVector<int> levels = order;   // already grouped by level
+
+    int lb = qMax(r.lowerBound, eccU);
+    if (eccU > r.lowerBound) { r.from = u; r.to = order.last(); }
+
+    // pairs left inside levels <= i are at most 2i apart
+    for (int i = eccU; i > 0 && lb < 2 * i; --i) {
+        for (int k = levelOffsets[i]; k < levelOffsets[i + 1]; ++k) {
+            const int e = bfs(levels[k]);
+            if (e > lb) { lb = e; r.from = levels[k]; r.to = order.last(); }
+        }
+    }
+    r.diameter = lb;
+    return r;
+}
+
+EccentricityResult eccentricityBounds(const CsrGraph& g)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+    EccentricityResult r;
+    r.eccentricity.fill(-1, N);
+    const int start = largestComponentNode(s, &r.componentSize);
+    if (start == -1) return r;
+
+    QVector<int> dist(N, -1), order;
+    bfsDistances(s, start, dist, order);
+    QVector<int> candidates = order;
+
+    QVector<int> lower(N, 0), upper(N, INT_MAX);
+    int diamLow = 0, radUp = INT_MAX;
+    bool pickUpper = false;
+
+    while (!candidates.isEmpty()) {
+        // alternate between the smallest lower bound and the largest upper bound, higher degree on ties
+        int v = candidates.first();
+        for (int w : candidates) {
+            const bool better = pickUpper
+                ? upper[w] > upper[v] || (upper[w] == upper[v] && s.degree(w) > s.degree(v))
+                : lower[w] < lower[v] || (lower[w] == lower[v] && s.degree(w) > s.degree(v));
+            if (better) v = w;
+        }
+        pickUpper = !pickUpper;
+
+        const int ecc = bfsDistances(s, v, dist, order);
+        ++r.bfsRuns;
+        lower[v] = upper[v] = ecc;
+
+        for (int w : order) {
+            lower[w] = qMax(lower[w], qMax(dist[w], ecc - dist[w]));
+            upper[w] = qMin(upper[w], ecc + dist[w]);
+            diamLow = qMax(diamLow, lower[w]);
+            radUp = qMin(radUp, upper[w]);
+        }
+
+        int kept = 0;
+        for (int w : candidates) {
+            if (lower[w] == upper[w]) continue;
+            if (lower[w] > radUp && upper[w] < diamLow) continue;
+            candidates[kept++] = w;
+        }
+        candidates.resize(kept);
+    }
+
+    // centre and periphery nodes are always resolved, pruned ones cannot reach either bound
+    bfsDistances(s, start, dist, order);
+    r.radius = radUp;
+    r.diameter = diamLow;
+    for (int w : order) {
+        if (lower[w] != upper[w]) continue;
+        r.eccentricity[w] = lower[w];
+        if (lower[w] == r.radius) r.centre.append(w);
+        if (lower[w] == r.diameter) r.periphery.append(w);
+    }
+    std::sort(r.centre.begin(), r.centre.end());
+    std::sort(r.periphery.begin(), r.periphery.end());
+    return r;
+}
+
+// ---------------------------------------------------------------
+// HyperANF
+// ---------------------------------------------------------------
+
+NeighbourhoodFunction hyperAnf(const CsrGraph& g, int log2Registers, int maxIterations)
+{
+    const int N = g.nodeCount;
+    const int b = qBound(4, log2Registers, 12);
+    const int m = 1 << b;
+
+    NeighbourhoodFunction r;
+    r.registers = m;
+    r.relativeError = 1.04 / std::sqrt(double(m));
+    if (N == 0) return r;
+
+    // 2^-k for every register value, the estimator sums these
+    double inversePow[66];
+    for (int k = 0; k < 66; ++k) inversePow[k] = std::ldexp(1.0, -k);
+    const double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / m);
+
+    auto estimate = [&](const quint8* row) {
+        double sum = 0.0;
+        int zeros = 0;
+        for (int j = 0; j < m; ++j) {
+            sum += inversePow[row[j]];
+            zeros += row[j] == 0;
+        }
+        const double e = alpha * m * m / sum;
+        // small range correction (linear counting)
+        return (e <= 2.5 * m && zeros > 0) ? m * std::log(double(m) / zeros) : e;
+    };
+
+    QVector<quint8> current(qsizetype(N) * m, 0), next(qsizetype(N) * m, 0);
+
+    // seed each counter with its own node, splitmix64 spreads the ids over the registers
+    int aliveCount = 0;
+    for (int v = 0; v < N; ++v) {
+        if (!g.alive[v]) continue;
+        ++aliveCount;
+        quint64 x = quint64(v) + 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        const int index = int(x >> (64 - b));
+        const quint64 rest = x << b;
+        const int rho = rest == 0 ? 64 - b + 1 : int(qCountLeadingZeroBits(rest)) + 1;
+        current[qint64(v) * m + index] = quint8(rho);
+    }
+    r.pairs.append(aliveCount);
+
+    const int workers = parallelWorkers(N / 256 + 1);
+    QVector<double> workerSum(workers);
+    QVector<char> workerChanged(workers);
+
+    for (int t = 0; t < maxIterations; ++t) {
+        const quint8* cur = current.constData();
+        quint8* nxt = next.data();
+        double* sums = workerSum.data();
+        char* changed = workerChanged.data();
+        workerSum.fill(0.0);
+        workerChanged.fill(0);
+
+        parallelFor(N, 256, [&](int begin, int end, int worker) {
+            double sum = 0.0;
+            bool any = false;
+            for (int v = begin; v < end; ++v) {
+                if (!g.alive[v]) continue;
+                quint8* dst = nxt + qint64(v) * m;
+                const quint8* own = cur + qint64(v) * m;
+                std::copy(own, own + m, dst);
+                for (int i = g.offsets[v]; i < g.offsets[v + 1]; ++i) {
+                    const int w = g.targets[i];
+                    if (!g.alive[w]) continue;
+                    // byte-wise max over the row, plain loop so it vectorises
+                    const quint8* src = cur + qint64(w) * m;
+                    for (int j = 0; j < m; ++j)
+                        dst[j] = dst[j] > src[j] ? dst[j] : src[j];
+                }
+                any = any || !std::equal(dst, dst + m, own);
+                sum += estimate(dst);
+            }
+            sums[worker] += sum;
+            changed[worker] |= any;
+        });
+
+        current.swap(next);
+        bool any = false;
+        double total = 0.0;
+        for (int w = 0; w < workers; ++w) {
+            total += workerSum[w];
+            any = any || workerChanged[w];
+        }
+        if (!any) { r.converged = true; break; }
+        // estimates are noisy, keep the function monotone
+        r.pairs.append(qMax(total, r.pairs.last()));
+    }
+
+    // distance distribution from the increments of N(t), self pairs excluded
+    const double reachable = r.pairs.last() - r.pairs.first();
+    if (reachable <= 0.0) return r;
+
+    double weighted = 0.0;
+    for (int t = 1; t < r.pairs.size(); ++t)
+        weighted += t * (r.pairs[t] - r.pairs[t - 1]);
+    r.averageDistance = weighted / reachable;
+
+    const double target = r.pairs.first() + 0.9 * reachable;
+    for (int t = 1; t < r.pairs.size(); ++t) {
+        if (r.pairs[t] < target) continue;
+        const double step = r.pairs[t] - r.pairs[t - 1];
+        r.effectiveDiameter = step > 0.0 ? t - 1 + (target - r.pairs[t - 1]) / step : t;
+        break;
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Betweenness centrality (Brandes)
+// ---------------------------------------------------------------
+
+namespace {
+
+// per-worker search state, reused for every source the worker handles
+struct BrandesWorker {
+    QVector<double> dist;
+    QVector<double> sigma;    // number of shortest paths from the source
+    QVector<double> delta;    // dependency of the source on each node
+    QVector<int> order;       // nodes in non-decreasing distance order
+    IndexedMinHeap heap;
+
+    QVector<double> sum;      // accumulated dependencies
+    QVector<double> sumSq;    // squared dependencies, only for sampling
+
+    void init(int n, bool sampled) {
+        dist.fill(std::numeric_limits<double>::infinity(), n);
+        sigma.fill(0.0, n);
+        delta.fill(0.0, n);
+        heap.reset(n);
+        sum.fill(0.0, n);
+        if (sampled) sumSq.fill(0.0, n);
+    }
+};
+
+// one Brandes pass. successors are found again from the CSR in the backward
+// sweep (dist[w] == dist[v] + w(v,w)) so no predecessor lists are stored
+void brandesFromSource(const CsrGraph& g, int s, bool weighted, BrandesWorker& w)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    w.order.clear();
+
+    w.dist[s] = 0.0;
+    w.sigma[s] = 1.0;
+
+    if (weighted) {
+        w.heap.push(s, 0.0);
+        while (!w.heap.isEmpty()) {
+            const int u = w.heap.popMin();
+            w.order.append(u);
+            for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                const int v = g.targets[i];
+                if (!g.alive[v] || v == u) continue;
+                const double alt = w.dist[u] + g.weights[i];
+                if (alt < w.dist[v]) {
+                    w.dist[v] = alt;
+                    w.sigma[v] = w.sigma[u];
+                    w.heap.push(v, alt);
+                } else if (alt == w.dist[v] && v != s) {
+                    w.sigma[v] += w.sigma[u];
+                }
+            }
+        }
+    } else {
+        // order doubles as the BFS queue
+        w.order.append(s);
+        for (int head = 0; head < w.order.size(); ++head) {
+            const int u = w.order[head];
+            for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                const int v = g.targets[i];
+                if (!g.alive[v] || v == u) continue;
+                if (w.dist[v] == INF) {
+                    w.dist[v] = w.dist[u] + 1.0;
+                    w.order.append(v);
+                }
+                if (w.dist[v] == w.dist[u] + 1.0) w.sigma[v] += w.sigma[u];
+            }
+        }
+    }
+
+    // dependencies in reverse distance order, then reset what this pass touched
+    for (int k = w.order.size() - 1; k >= 0; --k) {
+        const int u = w.order[k];
+        double d = 0.0;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (!g.alive[v] || v == u) continue;
+            const double step = weighted ? g.weights[i] : 1.0;
+            if (w.dist[v] == w.dist[u] + step && w.sigma[v] > 0.0 && v != s)
+                d += w.sigma[u] / w.sigma[v] * (1.0 + w.delta[v]);
+        }
+        w.delta[u] = d;
+        if (u != s) {
+            w.sum[u] += d;
+            if (!w.sumSq.isEmpty()) w.sumSq[u] += d * d;
+        }
+    }
+    for (int u : w.order) {
+        w.dist[u] = INF;
+        w.sigma[u] = 0.0;
+        w.delta[u] = 0.0;
+    }
+}
+
+} // namespace
+
+BetweennessResult betweennessCentrality(const CsrGraph& g, bool weighted, bool halveScores,
+                                        int sampleCount, quint32 seed)
+{
+    BetweennessResult r;
+    const int N = g.nodeCount;
+    r.score.fill(0.0, N);
+    r.stdError.fill(0.0, N);
+
+    QVector<int> sources;
+    for (int v = 0; v < N; ++v)
+        if (g.alive[v]) sources.append(v);
+    const int alive = sources.size();
+
+    // partial Fisher-Yates shuffle picks k distinct sources
+    if (sampleCount > 0 && sampleCount < alive) {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < sampleCount; ++i) {
+            std::uniform_int_distribution<int> pick(i, alive - 1);
+            std::swap(sources[i], sources[pick(rng)]);
+        }
+        sources.resize(sampleCount);
+        r.sampled = true;
+    }
+    r.sources = sources.size();
+    if (sources.isEmpty()) return r;
+
+    QVector<BrandesWorker> workers(parallelWorkers(sources.size()));
+    for (BrandesWorker& w : workers) w.init(N, r.sampled);
+
+    parallelFor(sources.size(), 4, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; ++i)
+            brandesFromSource(g, sources[i], weighted, workers[worker]);
+    });
+
+    // reduce the thread-local accumulators
+    QVector<double> sumSq(r.sampled ? N : 0, 0.0);
+    for (const BrandesWorker& w : workers) {
+        for (int v = 0; v < N; ++v) r.score[v] += w.sum[v];
+        if (r.sampled)
+            for (int v = 0; v < N; ++v) sumSq[v] += w.sumSq[v];
+    }
+
+    const double halve = halveScores ? 0.5 : 1.0;
+    if (!r.sampled) {
+        for (double& x : r.score) x *= halve;
+        return r;
+    }
+
+    // estimate = N * mean dependency, error from the sample variance with
+    // the finite population correction for sampling without replacement
+    const int k = r.sources;
+    const double fpc = alive > 1 ? double(alive - k) / (alive - 1) : 0.0;
+    for (int v = 0; v < N; ++v) {
+        const double mean = r.score[v] / k;
+        const double var = k > 1 ? qMax(0.0, (sumSq[v] - k * mean * mean) / (k - 1)) : 0.0;
+        r.score[v] = alive * mean * halve;
+        r.stdError[v] = alive * std::sqrt(var / k * fpc) * halve;
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------
+// PageRank / eigenvector centrality (power iteration)
+// ---------------------------------------------------------------
+
+namespace {
+
+// nodes per parallelFor chunk in the SpMV sweeps
+const int SPMV_GRAIN = 2048;
+
+// next[v] = sum of contrib over in-neighbours of v, plus bias[v] when given.
+// returns sum |next - prev| over alive nodes
+double pullSpMV(const CsrGraph& in, const QVector<float>& contrib, const QVector<float>& bias,
+                const QVector<float>& prev, QVector<float>& next)
+{
+    const int N = in.nodeCount;
+    QVector<double> residual(parallelWorkers((N + SPMV_GRAIN - 1) / SPMV_GRAIN), 0.0);
+
+    // raw pointers so the workers never touch the containers' shared state
+    float* out = next.data();
+    parallelFor(N, SPMV_GRAIN, [&](int begin, int end, int worker) {
+        const int* offsets = in.offsets.constData();
+        const int* sources = in.targets.constData();
+        const float* c = contrib.constData();
+        double local = 0.0;
+
+        for (int v = begin; v < end; ++v) {
+            if (!in.alive[v]) { out[v] = 0.0f; continue; }
+            float sum = bias.isEmpty() ? 0.0f : bias[v];
+            for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+                sum += c[sources[i]];
+            out[v] = sum;
+            local += std::fabs(double(sum) - prev[v]);
+        }
+        residual[worker] += local;
+    });
+
+    double total = 0.0;
+    for (double r : residual) total += r;
+    return total;
+}
+
+} // namespace
+
+PowerIterationResult pageRank(const CsrGraph& g, double damping, const QVector<double>& personalisation,
+                              double tolerance, int maxIterations)
+{
+    PowerIterationResult r;
+    const int N = g.nodeCount;
+    r.score.fill(0.0, N);
+
+    int alive = 0;
+    for (int v = 0; v < N; ++v)
+        if (g.alive[v]) ++alive;
+    if (alive == 0) return r;
+
+    // teleport distribution, falls back to uniform if nothing usable was given
+    QVector<float> teleport(N, 0.0f);
+    double mass = 0.0;
+    for (int v = 0; v < qMin(N, personalisation.size()); ++v)
+        if (g.alive[v] && personalisation[v] > 0.0) mass += personalisation[v];
+    for (int v = 0; v < N; ++v) {
+        if (!g.alive[v]) continue;
+        if (mass > 0.0) teleport[v] = v < personalisation.size() && personalisation[v] > 0.0
+                                          ? float(personalisation[v] / mass) : 0.0f;
+        else teleport[v] = 1.0f / alive;
+    }
+
+    // out-degree towards alive nodes only, a directed edge into a removed node carries no rank
+    QVector<int> outDegree(N, 0);
+    for (int u = 0; u < N; ++u) {
+        if (!g.alive[u]) continue;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+            if (g.alive[g.targets[i]]) ++outDegree[u];
+    }
+
+    const CsrGraph in = g.reversed();
+    QVector<float> rank(N, 0.0f), next(N, 0.0f), contrib(N, 0.0f), bias(N, 0.0f);
+    for (int v = 0; v < N; ++v)
+        if (g.alive[v]) rank[v] = 1.0f / alive;
+
+    const float d = float(damping);
+    while (r.iterations < maxIterations) {
+        // push side is only a scale per node, the dangling mass is one scalar
+        double dangling = 0.0;
+        for (int u = 0; u < N; ++u) {
+            const int deg = outDegree[u];
+            if (deg > 0) contrib[u] = d * rank[u] / deg;
+            else { contrib[u] = 0.0f; if (g.alive[u]) dangling += rank[u]; }
+        }
+        const float teleportScale = float((1.0 - damping) + damping * dangling);
+        for (int v = 0; v < N; ++v) bias[v] = teleportScale * teleport[v];
+
+        r.residual = pullSpMV(in, contrib, bias, rank, next);
+        std::swap(rank, next);
+        ++r.iterations;
+        if (r.residual < tolerance) { r.converged = true; break; }
+    }
+
+    for (int v = 0; v < N; ++v) r.score[v] = rank[v];
+    return r;
+}
+
+PowerIterationResult eigenvectorCentrality(const CsrGraph& g, double tolerance, int maxIterations)
+{
+    PowerIterationResult r;
+    const int N = g.nodeCount;
+    r.score.fill(0.0, N);
+
+    int alive = 0;
+    for (int v = 0; v < N; ++v)
+        if (g.alive[v]) ++alive;
+    if (alive == 0) return r;
+
+    const CsrGraph in = g.reversed();
+    QVector<float> x(N, 0.0f), next(N, 0.0f);
+    for (int v = 0; v < N; ++v)
+        if (g.alive[v]) x[v] = 1.0f / std::sqrt(float(alive));
+
+    while (r.iterations < maxIterations) {
+        // (A + I) x, the identity term is the bias
+        pullSpMV(in, x, x, x, next);
+
+        double norm = 0.0;
+        for (int v = 0; v < N; ++v) norm += double(next[v]) * next[v];
+        norm = std::sqrt(norm);
+        if (norm == 0.0) break;
+
+        double residual = 0.0;
+        for (int v = 0; v < N; ++v) {
+            next[v] = float(next[v] / norm);
+            residual += std::fabs(double(next[v]) - x[v]);
+        }
+        std::swap(x, next);
+        ++r.iterations;
+        r.residual = residual;
+        if (residual < tolerance) { r.converged = true; break; }
+    }
+
+    for (int v = 0; v < N; ++v) r.score[v] = x[v];
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Triangles and clustering coefficient
+// ---------------------------------------------------------------
+
+TriangleResult countTriangles(const CsrGraph& g)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    TriangleResult r;
+    r.perNode.fill(0, N);
+    r.clustering.fill(0.0, N);
+
+    // orientation: u -> v when (deg u, u) < (deg v, v), lists stay sorted by id
+    auto before = [&s](int u, int v) {
+        const int du = s.degree(u), dv = s.degree(v);
+        return du < dv || (du == dv && u < v);
+    };
+    QVector<int> fwdOffsets(N + 1, 0);
+    QVector<int> fwdTargets;
+    fwdTargets.reserve(s.targets.size() / 2);
+    for (int u = 0; u < N; ++u) {
+        fwdOffsets[u] = fwdTargets.size();
+        for (int i = s.offsets[u]; i < s.offsets[u + 1]; ++i)
+            if (before(u, s.targets[i])) fwdTargets.append(s.targets[i]);
+    }
+    fwdOffsets[N] = fwdTargets.size();
+
+    // per-worker counters, a triangle found at u also credits v and w
+    const int workers = parallelWorkers((N + 255) / 256);
+    QVector<QVector<qint64>> local(workers);
+    parallelFor(N, 256, [&](int begin, int end, int worker) {
+        QVector<qint64>& count = local[worker];
+        if (count.isEmpty()) count.fill(0, N);
+        const int* off = fwdOffsets.constData();
+        const int* adj = fwdTargets.constData();
+
+        for (int u = begin; u < end; ++u) {
+            for (int a = off[u]; a < off[u + 1]; ++a) {
+                const int v = adj[a];
+
+                // sorted merge of the oriented lists of u and v
+                int i = off[u], j = off[v];
+                while (i < off[u + 1] && j < off[v + 1]) {
+                    if (adj[i] < adj[j]) ++i;
+                    else if (adj[i] > adj[j]) ++j;
+                    else {
+                        ++count[u]; ++count[v]; ++count[adj[i]];
+                        ++i; ++j;
+                    }
+                }
+            }
+        }
+    });
+    for (const QVector<qint64>& count : local)
+        for (int v = 0; v < count.size(); ++v) r.perNode[v] += count[v];
+
+    // local and global coefficients
+    qint64 corners = 0;
+    double wedges = 0.0, clusteringSum = 0.0;
+    int alive = 0;
+    for (int v = 0; v < N; ++v) {
+        if (!s.alive[v]) continue;
+        ++alive;
+        corners += r.perNode[v];
+        const double d = s.degree(v);
+        const double pairs = d * (d - 1) / 2.0;
+        wedges += pairs;
+        if (pairs > 0) r.clustering[v] = r.perNode[v] / pairs;
+        clusteringSum += r.clustering[v];
+    }
+    r.triangles = corners / 3;
+    r.transitivity = wedges > 0 ? corners / wedges : 0.0;
+    r.averageClustering = alive ? clusteringSum / alive : 0.0;
+    return r;
+}
+
+// ---------------------------------------------------------------
+// k-core decomposition
+// ---------------------------------------------------------------
+
+QVector<int> coreNumbers(const CsrGraph& g)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    QVector<int> deg(N, -1);
+    int maxDeg = 0;
+    for (int v = 0; v < N; ++v) {
+        if (!s.alive[v]) continue;
+        deg[v] = s.degree(v);
+        maxDeg = qMax(maxDeg, deg[v]);
+    }
+
+    // counting sort into buckets: bin[d] is the first slot of degree d in vert
+    QVector<int> bin(maxDeg + 2, 0);
+    for (int v = 0; v < N; ++v)
+        if (deg[v] >= 0) ++bin[deg[v] + 1];
+    for (int d = 0; d <= maxDeg; ++d) bin[d + 1] += bin[d];
+
+    QVector<int> vert(bin[maxDeg + 1]), pos(N, -1);
+    {
+        QVector<int> fill = bin;
+        for (int v = 0; v < N; ++v) {
+            if (deg[v] < 0) continue;
+            pos[v] = fill[deg[v]]++;
+            vert[pos[v]] = v;
+        }
+    }
+
+    // peel in order, deg[v] becomes the core number once v is reached
+    for (int i = 0; i < vert.size(); ++i) {
+        const int v = vert[i];
+        for (int e = s.offsets[v]; e < s.offsets[v + 1]; ++e) {
+            const int u = s.targets[e];
+            if (deg[u] <= deg[v]) continue;
+
+            // swap u with the first node of its bucket, then shrink the bucket
+            const int du = deg[u];
+            const int first = bin[du];
+            const int w = vert[first];
+            if (u != w) {
+                vert[pos[u]] = w;
+                pos[w] = pos[u];
+                vert[first] = u;
+                pos[u] = first;
+            }
+            ++bin[du];
+            --deg[u];
+        }
+    }
+    return deg;
+}
+
+QVector<int> coreNumbersParallel(const CsrGraph& g, int* rounds)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    QVector<int> core(N, -1), next(N, -1);
+    for (int v = 0; v < N; ++v)
+        if (s.alive[v]) core[v] = s.degree(v);
+
+    const int grain = 512;
+    const int workers = parallelWorkers((N + grain - 1) / grain);
+    QVector<QVector<int>> counts(workers);
+    int sweeps = 0;
+
+    // synchronous sweeps, reading core and writing next keeps workers independent
+    while (true) {
+        ++sweeps;
+        std::atomic<bool> changed(false);
+        const int* cur = core.constData();
+        int* out = next.data();
+
+        parallelFor(N, grain, [&](int begin, int end, int worker) {
+            QVector<int>& count = counts[worker];
+            bool localChanged = false;
+
+            for (int v = begin; v < end; ++v) {
+                const int k = cur[v];
+                if (k <= 0) { out[v] = k; continue; }
+
+                // h-index of the neighbour estimates, capped at the current value
+                if (count.size() < k + 1) count.resize(k + 1);
+                std::fill(count.begin(), count.begin() + k + 1, 0);
+                for (int e = s.offsets[v]; e < s.offsets[v + 1]; ++e)
+                    ++count[qMin(cur[s.targets[e]], k)];
+
+                int h = k, atLeast = 0;
+                for (; h > 0; --h) {
+                    atLeast += count[h];
+                    if (atLeast >= h) break;
+                }
+                out[v] = h;
+                if (h != k) localChanged = true;
+            }
+            if (localChanged) changed = true;
+        });
+
+        std::swap(core, next);
+        if (!changed) break;
+    }
+
+    if (rounds) *rounds = sweeps;
+    return core;
+}
+
+// ---------------------------------------------------------------
+// Strongly connected components
+// ---------------------------------------------------------------
+
+SccResult stronglyConnectedComponents(const CsrGraph& g)
+{
+    const int N = g.nodeCount;
+    SccResult r;
+    r.component.fill(-1, N);
+
+    QVector<int> index(N, -1), low(N, 0);
+    QVector<bool> onStack(N, false);
+    QVector<int> sccStack;
+
+    // one frame per active call: the node and the next edge slot to look at
+    struct Frame { int node; int edge; };
+    QVector<Frame> callStack;
+    int nextIndex = 0;
+
+    for (int root = 0; root < N; ++root) {
+        if (!g.alive[root] || index[root] != -1) continue;
+
+        index[root] = low[root] = nextIndex++;
+        sccStack.append(root);
+        onStack[root] = true;
+        callStack.append(Frame{root, g.offsets[root]});
+
+        while (!callStack.isEmpty()) {
+            Frame& f = callStack.last();
+            const int u = f.node;
+
+            if (f.edge < g.offsets[u + 1]) {
+                const int v = g.targets[f.edge++];
+                if (!g.alive[v]) continue;
+                if (index[v] == -1) {
+                    // descend, f is invalid after the append
+                    index[v] = low[v] = nextIndex++;
+                    sccStack.append(v);
+                    onStack[v] = true;
+                    callStack.append(Frame{v, g.offsets[v]});
+                } else if (onStack[v]) {
+                    low[u] = qMin(low[u], index[v]);
+                }
+                continue;
+            }
+
+            // all edges done: pop a component if u is its root, then return to the parent
+            if (low[u] == index[u]) {
+                int size = 0, w;
+                do {
+                    w = sccStack.takeLast();
+                    onStack[w] = false;
+                    r.component[w] = r.count;
+                    ++size;
+                } while (w != u);
+                r.sizes.append(size);
+                ++r.count;
+            }
+            callStack.removeLast();
+            if (!callStack.isEmpty()) {
+                const int parent = callStack.last().node;
+                low[parent] = qMin(low[parent], low[u]);
+            }
+        }
+    }
+
+    // Tarjan finishes sinks first, flip the ids so they are topologically ordered
+    for (int& c : r.component)
+        if (c != -1) c = r.count - 1 - c;
+    std::reverse(r.sizes.begin(), r.sizes.end());
+
+    // condensation: bucket the crossing edges by source component, then dedupe each bucket
+    r.dagOffsets.fill(0, r.count + 1);
+    for (int u = 0; u < N; ++u) {
+        if (r.component[u] == -1) continue;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int cv = r.component[g.targets[i]];
+            if (cv != -1 && cv != r.component[u]) ++r.dagOffsets[r.component[u] + 1];
+        }
+    }
+    for (int c = 0; c < r.count; ++c) r.dagOffsets[c + 1] += r.dagOffsets[c];
+
+    QVector<int> fill = r.dagOffsets;
+    r.dagTargets.resize(r.dagOffsets[r.count]);
+    for (int u = 0; u < N; ++u) {
+        const int cu = r.component[u];
+        if (cu == -1) continue;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int cv = r.component[g.targets[i]];
+            if (cv != -1 && cv != cu) r.dagTargets[fill[cu]++] = cv;
+        }
+    }
+
+    int out = 0;
+    for (int c = 0; c < r.count; ++c) {
+        const int begin = r.dagOffsets[c], end = r.dagOffsets[c + 1];
+        std::sort(r.dagTargets.begin() + begin, r.dagTargets.begin() + end);
+        r.dagOffsets[c] = out;
+        for (int i = begin; i < end; ++i)
+            if (i == begin || r.dagTargets[i] != r.dagTargets[i - 1]) r.dagTargets[out++] = r.dagTargets[i];
+    }
+    r.dagOffsets[r.count] = out;
+    r.dagTargets.resize(out);
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Biconnected components
+// ---------------------------------------------------------------
+
+BiconnectedResult biconnectedComponents(const CsrGraph& g)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    BiconnectedResult r;
+    r.articulation.fill(false, N);
+    r.blocksPerNode.fill(0, N);
+    r.blockOffsets.append(0);
+
+    QVector<int> disc(N, -1), low(N, 0);
+    QVector<int> stamp(N, -1);                // last block a node was added to
+    QVector<QPair<int,int>> edgeStack;        // tree and back edges not yet assigned to a block
+
+    // one frame per active call: node, its tree parent and the next edge slot
+    struct Frame { int node; int parent; int edge; };
+    QVector<Frame> callStack;
+    int nextDisc = 0;
+
+    auto addToBlock = [&](int v) {
+        if (stamp[v] == r.blockCount()) return;
+        stamp[v] = r.blockCount();
+        r.blockNodes.append(v);
+        ++r.blocksPerNode[v];
+    };
+
+    for (int root = 0; root < N; ++root) {
+        if (!s.alive[root] || disc[root] != -1) continue;
+
+        disc[root] = low[root] = nextDisc++;
+        callStack.append(Frame{root, -1, s.offsets[root]});
+        int rootChildren = 0;
+
+        while (!callStack.isEmpty()) {
+            Frame& f = callStack.last();
+            const int u = f.node;
+
+            if (f.edge < s.offsets[u + 1]) {
+                const int v = s.targets[f.edge++];
+                if (disc[v] == -1) {
+                    // tree edge, f is invalid after the append
+                    if (u == root) ++rootChildren;
+                    edgeStack.append(qMakePair(u, v));
+                    disc[v] = low[v] = nextDisc++;
+                    callStack.append(Frame{v, u, s.offsets[v]});
+                } else if (v != f.parent && disc[v] < disc[u]) {
+                    // back edge to an ancestor, each one is pushed once from its lower end
+                    edgeStack.append(qMakePair(u, v));
+                    low[u] = qMin(low[u], disc[v]);
+                }
+                continue;
+            }
+
+            // u is finished, fold its low into the parent and cut a block if the parent separates it
+            const int p = f.parent;
+            callStack.removeLast();
+            if (p == -1) continue;
+
+            low[p] = qMin(low[p], low[u]);
+            if (low[u] >= disc[p]) {
+                if (p != root) r.articulation[p] = true;
+                if (low[u] > disc[p]) r.bridges.append(qMakePair(qMin(p, u), qMax(p, u)));
+
+                QPair<int,int> e;
+                do {
+                    e = edgeStack.takeLast();
+                    addToBlock(e.first);
+                    addToBlock(e.second);
+                } while (e.first != p || e.second != u);
+                r.blockOffsets.append(r.blockNodes.size());
+            }
+        }
+
+        // the root separates only when the DFS left it through more than one tree edge
+        if (rootChildren > 1) r.articulation[root] = true;
+    }
+
+    std::sort(r.bridges.begin(), r.bridges.end());
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Minimum spanning forest
+// ---------------------------------------------------------------
+
+namespace {
+
+struct WeightedEdge {
+    double w;
+    int u, v;
+    bool operator<(const WeightedEdge& o) const {
+        return w < o.w || (w == o.w && (u < o.u || (u == o.u && v < o.v)));
+    }
+};
+
+// union-find with path halving and union by size
+struct DisjointSets {
+    QVector<int> parent, size;
+    explicit DisjointSets(int n) : parent(n), size(n, 1) { std::iota(parent.begin(), parent.end(), 0); }
+    int find(int x) {
+        while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+        return x;
+    }
+    bool unite(int a, int b) {
+        a = find(a); b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+};
+
+// sort chunks on the workers, then merge neighbouring runs in parallel rounds
+template <typename T>
+void parallelSort(QVector<T>& list)
+{
+    const int n = list.size();
+    const int chunks = parallelWorkers(n / 16384 + 1);
+    if (chunks <= 1) { std::sort(list.begin(), list.end()); return; }
+
+    QVector<int> bounds(chunks + 1);
+    for (int c = 0; c <= chunks; ++c) bounds[c] = int(qint64(n) * c / chunks);
+
+    T* data = list.data();
+    parallelFor(chunks, 1, [&](int begin, int end, int) {
+        for (int c = begin; c < end; ++c) std::sort(data + bounds[c], data + bounds[c + 1]);
+    });
+    for (int width = 1; width < chunks; width *= 2) {
+        const int pairs = (chunks + 2 * width - 1) / (2 * width);
+        parallelFor(pairs, 1, [&](int begin, int end, int) {
+            for (int p = begin; p < end; ++p) {
+                const int lo = p * 2 * width;
+                const int mid = qMin(lo + width, chunks), hi = qMin(lo + 2 * width, chunks);
+                if (mid < hi) std::inplace_merge(data + bounds[lo], data + bounds[mid], data + bounds[hi]);
+            }
+        });
+    }
+}
+
+} // namespace
+
+SpanningForestResult minimumSpanningForest(const CsrGraph& g, MstMethod method)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    SpanningForestResult r;
+    if (method == MstMethod::Auto)
+        method = s.targets.size() / 2 < MST_BORUVKA_EDGES ? MstMethod::Kruskal : MstMethod::Boruvka;
+    r.method = method;
+
+    int aliveCount = 0;
+    for (int v = 0; v < N; ++v) aliveCount += s.alive[v];
+
+    auto take = [&r](const WeightedEdge& e) {
+        r.edges.append(qMakePair(e.u, e.v));
+        r.weights.append(e.w);
+        r.totalWeight += e.w;
+    };
+
+    if (method == MstMethod::Kruskal) {
+        QVector<WeightedEdge> list;
+        list.reserve(s.targets.size() / 2);
+        for (int u = 0; u < N; ++u)
+            for (int i = s.offsets[u]; i < s.offsets[u + 1]; ++i)
+                if (u < s.targets[i]) list.append(WeightedEdge{s.weights[i], u, s.targets[i]});
+        parallelSort(list);
+
+        DisjointSets sets(N);
+        for (const WeightedEdge& e : list) {
+            if (!sets.unite(e.u, e.v)) continue;
+            take(e);
+            if (r.edges.size() == aliveCount - 1) break;
+        }
+        r.trees = aliveCount - r.edges.size();
+        return r;
+    }
+
+    // Boruvka: comp[v] is the component root, every round at least halves the components
+    QVector<int> comp(N);
+    std::iota(comp.begin(), comp.end(), 0);
+    QVector<WeightedEdge> nodeBest(N);
+    QVector<WeightedEdge> compBest(N);
+    const WeightedEdge none{std::numeric_limits<double>::infinity(), INT_MAX, INT_MAX};
+    DisjointSets sets(N);
+
+    const int* offsets = s.offsets.constData();
+    const int* targets = s.targets.constData();
+    const double* weights = s.weights.constData();
+
+    while (true) {
+        ++r.rounds;
+        const int* compPtr = comp.constData();
+        WeightedEdge* nodeBestPtr = nodeBest.data();
+
+        // lightest edge leaving each node's component, no contention since each node writes its own slot
+        parallelFor(N, 1024, [&](int begin, int end, int) {
+            for (int u = begin; u < end; ++u) {
+                WeightedEdge best = none;
+                const int cu = compPtr[u];
+                for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+                    const int v = targets[i];
+                    if (compPtr[v] == cu) continue;
+                    const WeightedEdge e{weights[i], qMin(u, v), qMax(u, v)};
+                    if (e < best) best = e;
+                }
+                nodeBestPtr[u] = best;
+            }
+        });
+
+        // reduce to one candidate per component
+        compBest.fill(none);
+        for (int u = 0; u < N; ++u)
+            if (nodeBest[u] < compBest[comp[u]]) compBest[comp[u]] = nodeBest[u];
+
+        // hook, the total edge order rules out cycles other than two components picking the same edge
+        bool merged = false;
+        for (int c = 0; c < N; ++c) {
+            const WeightedEdge& e = compBest[c];
+            if (e.u == INT_MAX || !sets.unite(e.u, e.v)) continue;
+            take(e);
+            merged = true;
+        }
+        if (!merged) break;
+
+        // path halving leaves chains behind, so resolve every root before the next scan
+        for (int v = 0; v < N; ++v) comp[v] = sets.find(v);
+    }
+
+    r.trees = aliveCount - r.edges.size();
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Maximum flow
+// ---------------------------------------------------------------
+
+MaxFlowResult maxFlowMinCut(const CsrGraph& g, int source, int sink)
+{
+    const int N = g.nodeCount;
+    MaxFlowResult r;
+    r.sourceSide.fill(false, N);
+    if (source < 0 || source >= N || sink < 0 || sink >= N || source == sink) return r;
+    if (!g.alive[source] || !g.alive[sink]) return r;
+
+    // residual arcs: edge u->v gives a forward arc with its capacity at u and a
+    // paired reverse arc with none at v, grouped by tail with a counting sort
+    QVector<int> arcOffsets(N + 1, 0);
+    for (int u = 0; u < N; ++u) {
+        if (!g.alive[u]) continue;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (v == u || !g.alive[v]) continue;
+            ++arcOffsets[u + 1];
+            ++arcOffsets[v + 1];
+        }
+    }
+    for (int u = 0; u < N; ++u) arcOffsets[u + 1] += arcOffsets[u];
+
+    const int arcCount = arcOffsets[N];
+    QVector<int> head(arcCount), rev(arcCount);
+    QVector<double> cap(arcCount);
+    QVector<int> fill = arcOffsets;
+    for (int u = 0; u < N; ++u) {
+        if (!g.alive[u]) continue;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (v == u || !g.alive[v]) continue;
+            const int a = fill[u]++, b = fill[v]++;
+            head[a] = v; cap[a] = qMax(0.0, g.weights[i]); rev[a] = b;
+            head[b] = u; cap[b] = 0.0;                    rev[b] = a;
+        }
+    }
+
+    QVector<int> height(N, N), current(N);
+    QVector<double> excess(N, 0.0);
+
+    // active nodes per height as stacks, all nodes per height as doubly linked lists for the gap check
+    QVector<int> activeHead(N + 1, -1), activeNext(N, -1);
+    QVector<int> allHead(N + 1, -1), allNext(N, -1), allPrev(N, -1);
+    int maxActive = -1, maxHeight = 0;
+
+    auto addActive = [&](int v) {
+        activeNext[v] = activeHead[height[v]];
+        activeHead[height[v]] = v;
+        maxActive = qMax(maxActive, height[v]);
+    };
+    auto addAll = [&](int v) {
+        const int h = height[v];
+        allPrev[v] = -1;
+        allNext[v] = allHead[h];
+        if (allHead[h] != -1) allPrev[allHead[h]] = v;
+        allHead[h] = v;
+        maxHeight = qMax(maxHeight, h);
+    };
+    auto removeAll = [&](int v) {
+        const int h = height[v];
+        if (allPrev[v] != -1) allNext[allPrev[v]] = allNext[v];
+        else allHead[h] = allNext[v];
+        if (allNext[v] != -1) allPrev[allNext[v]] = allPrev[v];
+    };
+
+    // exact distances to the sink in the residual graph, nodes that cannot reach it leave play
+    QVector<int> queue;
+    queue.reserve(N);
+    auto globalRelabel = [&]() {
+        ++r.globalRelabels;
+        height.fill(N);
+        activeHead.fill(-1);
+        allHead.fill(-1);
+        maxActive = -1;
+        maxHeight = 0;
+
+        queue.clear();
+        height[sink] = 0;
+        queue.append(sink);
+        for (int qi = 0; qi < queue.size(); ++qi) {
+            const int v = queue[qi];
+            for (int a = arcOffsets[v]; a < arcOffsets[v + 1]; ++a) {
+                const int u = head[a];
+                if (height[u] != N || u == source || cap[rev[a]] <= 0.0) continue;
+                height[u] = height[v] + 1;
+                current[u] = arcOffsets[u];
+                addAll(u);
+                if (excess[u] > 0.0) addActive(u);
+                queue.append(u);
+            }
+        }
+    };
+
+    // saturate everything leaving the source
+    for (int a = arcOffsets[source]; a < arcOffsets[source + 1]; ++a) {
+        const double f = cap[a];
+        if (f <= 0.0) continue;
+        cap[a] = 0.0;
+        cap[rev[a]] += f;
+        excess[head[a]] += f;
+        excess[source] -= f;
+    }
+    globalRelabel();
+
+    const qint64 relabelBudget = 6LL * N + arcCount;
+    qint64 work = 0;
+
+    while (maxActive >= 0) {
+        const int u = activeHead[maxActive];
+        if (u == -1) { --maxActive; continue; }
+        activeHead[maxActive] = activeNext[u];
+
+        // discharge: push along admissible arcs, relabel when the current arc runs out
+        while (excess[u] > 0.0) {
+            if (current[u] == arcOffsets[u + 1]) {
+                ++r.relabels;
+                work += 12 + arcOffsets[u + 1] - arcOffsets[u];
+
+                const int old = height[u];
+                removeAll(u);
+                if (allHead[old] == -1) {
+                    // gap: nothing is left at old, so nothing above it can reach the sink
+                    for (int h = old + 1; h <= maxHeight; ++h) {
+                        for (int v = allHead[h]; v != -1; v = allNext[v]) {
+                            height[v] = N;
+                            ++r.gapNodes;
+                        }
+                        allHead[h] = -1;
+                        activeHead[h] = -1;
+                    }
+                    maxHeight = old - 1;
+                    height[u] = N;
+                    break;
+                }
+
+                int best = N;
+                for (int a = arcOffsets[u]; a < arcOffsets[u + 1]; ++a) {
+                    if (cap[a] > 0.0 && height[head[a]] + 1 < best) {
+                        best = height[head[a]] + 1;
+                        current[u] = a;
+                    }
+                }
+                height[u] = best;
+                if (best >= N) break;
+                addAll(u);
+                continue;
+            }
+
+            const int a = current[u];
+            const int v = head[a];
+            if (cap[a] > 0.0 && height[u] == height[v] + 1) {
+                const double d = qMin(excess[u], cap[a]);
+                const bool wasIdle = excess[v] <= 0.0;
+                cap[a] -= d;
+                cap[rev[a]] += d;
+                excess[u] -= d;
+                excess[v] += d;
+                ++r.pushes;
+                if (wasIdle && v != sink) addActive(v);
+            } else {
+                ++current[u];
+            }
+        }
+
+        if (work > relabelBudget) {
+            work = 0;
+            globalRelabel();
+        }
+    }
+    r.value = excess[sink];
+
+    // sink side = everything that still reaches the sink through residual arcs
+    QVector<bool> reachesSink(N, false);
+    queue.clear();
+    reachesSink[sink] = true;
+    queue.append(sink);
+    for (int qi = 0; qi < queue.size(); ++qi) {
+        const int v = queue[qi];
+        for (int a = arcOffsets[v]; a < arcOffsets[v + 1]; ++a) {
+            const int u = head[a];
+            if (reachesSink[u] || cap[rev[a]] <= 0.0) continue;
+            reachesSink[u] = true;
+            queue.append(u);
+        }
+    }
+    for (int u = 0; u < N; ++u)
+        r.sourceSide[u] = g.alive[u] && !reachesSink[u];
+
+    for (int u = 0; u < N; ++u) {
+        if (!r.sourceSide[u]) continue;
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (!g.alive[v] || r.sourceSide[v] || g.weights[i] <= 0.0) continue;
+            r.cutEdges.append(qMakePair(u, v));
+            r.cutCapacities.append(g.weights[i]);
+        }
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Community detection (Louvain)
+// ---------------------------------------------------------------
+
+namespace {
+
+// symmetric weighted graph of one Louvain level, a self loop holds a community's
+// internal weight counted from both ends
+struct LevelGraph {
+    int n = 0;
+    QVector<int> offsets;
+    QVector<int> targets;
+    QVector<double> weights;
+};
+
+struct KeyedWeight {
+    quint64 key;   // (from << 32) | to
+    double w;
+    bool operator<(const KeyedWeight& o) const { return key < o.key; }
+};
+
+double levelModularity(const LevelGraph& h, const QVector<int>& comm, const QVector<double>& k,
+                       double m2, double gamma)
+{
+    QVector<double> in(h.n, 0.0), tot(h.n, 0.0);
+    for (int u = 0; u < h.n; ++u) {
+        tot[comm[u]] += k[u];
+        for (int i = h.offsets[u]; i < h.offsets[u + 1]; ++i)
+            if (comm[h.targets[i]] == comm[u]) in[comm[u]] += h.weights[i];
+    }
+    double q = 0.0;
+    for (int c = 0; c < h.n; ++c)
+        q += in[c] / m2 - gamma * (tot[c] / m2) * (tot[c] / m2);
+    return q;
+}
+
+// moves nodes between communities until a sweep stops paying off, true if any node moved
+bool louvainLocalMoving(const LevelGraph& h, QVector<int>& comm, const QVector<double>& k,
+                        double m2, double gamma, double* modularity)
+{
+    const int n = h.n;
+    const int SLICES = 4;
+    const int MAX_SWEEPS = 32;
+
+    QVector<double> tot(n, 0.0);
+    QVector<int> size(n, 0);
+    for (int u = 0; u < n; ++u) { tot[comm[u]] += k[u]; ++size[comm[u]]; }
+
+    QVector<int> target(n);
+    QVector<QVector<QPair<int,double>>> buffers(parallelWorkers(n / 512 + 1));
+    double q = levelModularity(h, comm, k, m2, gamma);
+    bool movedAny = false;
+
+    for (int sweep = 0; sweep < MAX_SWEEPS; ++sweep) {
+        const QVector<int> before = comm;
+        int moved = 0;
+
+        for (int slice = 0; slice < SLICES; ++slice) {
+            const int* commPtr = comm.constData();
+            const double* totPtr = tot.constData();
+            const int* sizePtr = size.constData();
+            int* targetPtr = target.data();
+
+            parallelFor(n, 512, [&](int begin, int end, int worker) {
+                QVector<QPair<int,double>>& links = buffers[worker];
+                for (int v = begin; v < end; ++v) {
+                    targetPtr[v] = -1;
+                    if (int((quint32(v) * 2654435761u + quint32(sweep) * 40503u) >> 30) != slice) continue;
+
+                    // weight from v into each neighbouring community
+                    links.clear();
+                    for (int i = h.offsets[v]; i < h.offsets[v + 1]; ++i)
+                        if (h.targets[i] != v) links.append(qMakePair(commPtr[h.targets[i]], h.weights[i]));
+                    std::sort(links.begin(), links.end(),
+                              [](const QPair<int,double>& a, const QPair<int,double>& b) { return a.first < b.first; });
+
+                    const int own = commPtr[v];
+                    double ownWeight = 0.0;
+                    for (const QPair<int,double>& l : links)
+                        if (l.first == own) ownWeight += l.second;
+
+                    int best = own;
+                    double bestGain = ownWeight - gamma * k[v] * (totPtr[own] - k[v]) / m2;
+                    for (int i = 0; i < links.size();) {
+                        const int c = links[i].first;
+                        double w = 0.0;
+                        for (; i < links.size() && links[i].first == c; ++i) w += links[i].second;
+                        if (c == own) continue;
+                        const double gain = w - gamma * k[v] * totPtr[c] / m2;
+                        if (gain > bestGain + 1e-12 || (best != own && gain > bestGain - 1e-12 && c < best)) {
+                            best = c;
+                            bestGain = gain;
+                        }
+                    }
+                    // singletons only merge towards the lower id
+                    if (best != own && sizePtr[own] == 1 && sizePtr[best] == 1 && best > own) best = own;
+                    targetPtr[v] = best;
+                }
+            });
+
+            for (int v = 0; v < n; ++v) {
+                const int to = target[v];
+                if (to == -1 || to == comm[v]) continue;
+                tot[comm[v]] -= k[v];
+                --size[comm[v]];
+                comm[v] = to;
+                tot[to] += k[v];
+                ++size[to];
+                ++moved;
+            }
+        }
+
+        const double next = levelModularity(h, comm, k, m2, gamma);
+        if (next < q) {
+            // simultaneous moves overshot, keep the previous assignment
+            comm = before;
+            break;
+        }
+        movedAny = movedAny || moved > 0;
+        const double gained = next - q;
+        q = next;
+        if (moved == 0 || gained < 1e-6) break;
+    }
+
+    *modularity = q;
+    return movedAny;
+}
+
+// one node per community, parallel edges summed through a sort of packed keys
+LevelGraph aggregateLevel(const LevelGraph& h, const QVector<int>& comm, int communities)
+{
+    QVector<KeyedWeight> entries;
+    entries.reserve(h.targets.size());
+    for (int u = 0; u < h.n; ++u)
+        for (int i = h.offsets[u]; i < h.offsets[u + 1]; ++i)
+            entries.append(KeyedWeight{(quint64(comm[u]) << 32) | quint32(comm[h.targets[i]]), h.weights[i]});
+    parallelSort(entries);
+
+    LevelGraph a;
+    a.n = communities;
+    a.offsets.fill(0, communities + 1);
+    for (int i = 0; i < entries.size(); ++i) {
+        if (i > 0 && entries[i].key == entries[i - 1].key) {
+            a.weights.last() += entries[i].w;
+            continue;
+        }
+        a.targets.append(int(entries[i].key & 0xffffffffu));
+        a.weights.append(entries[i].w);
+        ++a.offsets[int(entries[i].key >> 32) + 1];
+    }
+    for (int c = 0; c < communities; ++c) a.offsets[c + 1] += a.offsets[c];
+    return a;
+}
+
+// dense community ids by decreasing size from arbitrary labels in [0, N), -1 for removed ids
+void rankCommunities(const QVector<int>& label, CommunityResult& r)
+{
+    const int N = label.size();
+    QVector<int> sizes(N, 0);
+    for (int c : label) if (c != -1) ++sizes[c];
+
+    QVector<int> order;
+    for (int c = 0; c < N; ++c) if (sizes[c] > 0) order.append(c);
+    std::stable_sort(order.begin(), order.end(), [&sizes](int a, int b) { return sizes[a] > sizes[b]; });
+
+    QVector<int> rank(N, -1);
+    r.sizes.clear();
+    for (int i = 0; i < order.size(); ++i) {
+        rank[order[i]] = i;
+        r.sizes.append(sizes[order[i]]);
+    }
+    r.count = order.size();
+    r.community.fill(-1, N);
+    for (int v = 0; v < N; ++v)
+        if (label[v] != -1) r.community[v] = rank[label[v]];
+}
+
+} // namespace
+
+CommunityResult louvainCommunities(const CsrGraph& g, double resolution)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    CommunityResult r;
+    r.community.fill(-1, N);
+
+    // level 0: the alive nodes, compacted, every edge weight 1
+    QVector<int> compact(N, -1), original;
+    for (int v = 0; v < N; ++v)
+        if (s.alive[v]) { compact[v] = original.size(); original.append(v); }
+    if (original.isEmpty()) return r;
+
+    LevelGraph h;
+    h.n = original.size();
+    h.offsets.reserve(h.n + 1);
+    h.offsets.append(0);
+    for (int v : original) {
+        for (int i = s.offsets[v]; i < s.offsets[v + 1]; ++i) {
+            h.targets.append(compact[s.targets[i]]);
+            h.weights.append(1.0);
+        }
+        h.offsets.append(h.targets.size());
+    }
+
+    QVector<int> nodeComm(h.n);
+    std::iota(nodeComm.begin(), nodeComm.end(), 0);
+
+    const double m2 = h.targets.size();
+    if (m2 > 0.0) {
+        while (true) {
+            QVector<double> k(h.n, 0.0);
+            for (int u = 0; u < h.n; ++u)
+                for (int i = h.offsets[u]; i < h.offsets[u + 1]; ++i) k[u] += h.weights[i];
+
+            QVector<int> comm(h.n);
+            std::iota(comm.begin(), comm.end(), 0);
+            double q = 0.0;
+            const bool moved = louvainLocalMoving(h, comm, k, m2, resolution, &q);
+            r.levelModularity.append(q);
+            r.modularity = q;
+            if (!moved) break;
+            ++r.levels;
+
+            // dense ids for the next level
+            QVector<int> dense(h.n, -1);
+            int communities = 0;
+            for (int u = 0; u < h.n; ++u) {
+                if (dense[comm[u]] == -1) dense[comm[u]] = communities++;
+                comm[u] = dense[comm[u]];
+            }
+            for (int& c : nodeComm) c = comm[c];
+            if (communities == h.n) break;
+            h = aggregateLevel(h, comm, communities);
+        }
+    }
+
+    QVector<int> label(N, -1);
+    for (int i = 0; i < original.size(); ++i) label[original[i]] = nodeComm[i];
+    rankCommunities(label, r);
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Label propagation
+// ---------------------------------------------------------------
+
+CommunityResult labelPropagation(const CsrGraph& g, int maxSweeps, quint32 seed)
+{
+    const CsrGraph s = g.symmetrized();
+    const int N = s.nodeCount;
+
+    CommunityResult r;
+    r.community.fill(-1, N);
+
+    QVector<int> order;
+    for (int v = 0; v < N; ++v)
+        if (s.alive[v]) order.append(v);
+    if (order.isEmpty()) return r;
+
+    // labels are read while other workers write them, relaxed atomics keep that well defined
+    std::unique_ptr<std::atomic<int>[]> labels(new std::atomic<int>[N]);
+    for (int v = 0; v < N; ++v) labels[v].store(v, std::memory_order_relaxed);
+
+    const int grain = 1024;
+    const int blocks = (order.size() + grain - 1) / grain;
+    QVector<QVector<int>> buffers(parallelWorkers(blocks));
+    int* orderPtr = order.data();
+
+    for (int sweep = 0; sweep < maxSweeps; ++sweep) {
+        ++r.sweeps;
+
+        // fresh random order each sweep: shuffle inside blocks, then the dynamic chunks mix them
+        parallelFor(blocks, 1, [&](int begin, int end, int) {
+            for (int b = begin; b < end; ++b) {
+                std::mt19937 rng(seed ^ (quint32(sweep) * 0x9E3779B9u) ^ (quint32(b) * 0x85EBCA6Bu));
+                std::shuffle(orderPtr + b * grain, orderPtr + qMin((b + 1) * grain, order.size()), rng);
+            }
+        });
+
+        std::atomic<qint64> changed(0);
+        parallelFor(order.size(), grain, [&](int begin, int end, int worker) {
+            QVector<int>& counts = buffers[worker];
+            qint64 localChanged = 0;
+
+            for (int k = begin; k < end; ++k) {
+                const int v = orderPtr[k];
+                if (s.degree(v) == 0) continue;
+
+                // neighbour labels, sorted so equal labels are adjacent
+                counts.clear();
+                for (int i = s.offsets[v]; i < s.offsets[v + 1]; ++i)
+                    counts.append(labels[s.targets[i]].load(std::memory_order_relaxed));
+                std::sort(counts.begin(), counts.end());
+
+                const int own = labels[v].load(std::memory_order_relaxed);
+                int best = own, bestCount = 0, ownCount = 0;
+                quint32 bestKey = 0;
+                for (int i = 0; i < counts.size();) {
+                    const int label = counts[i];
+                    int count = 0;
+                    for (; i < counts.size() && counts[i] == label; ++i) ++count;
+                    if (label == own) ownCount = count;
+                    // hashed tie-break, different per node and sweep
+                    const quint32 key = (quint32(label) ^ (quint32(v) * 2654435761u)) * (quint32(sweep) | 1u) * 0x85EBCA6Bu;
+                    if (count > bestCount || (count == bestCount && key > bestKey)) {
+                        best = label;
+                        bestCount = count;
+                        bestKey = key;
+                    }
+                }
+
+                // keeping a label that is tied for the most frequent is what lets the sweeps end
+                if (ownCount == bestCount || best == own) continue;
+                labels[v].store(best, std::memory_order_relaxed);
+                ++localChanged;
+            }
+            changed += localChanged;
+        });
+
+        if (changed == 0) { r.converged = true; break; }
+    }
+
+    QVector<int> label(N, -1);
+    for (int v : order) label[v] = labels[v].load(std::memory_order_relaxed);
+    rankCommunities(label, r);
+
+    // modularity with unit weights, for comparison with Louvain
+    const double m2 = s.targets.size();
+    if (m2 > 0.0) {
+        QVector<double> in(r.count, 0.0), tot(r.count, 0.0);
+        for (int v : order) {
+            const int c = r.community[v];
+            tot[c] += s.degree(v);
+            for (int i = s.offsets[v]; i < s.offsets[v + 1]; ++i)
+                if (r.community[s.targets[i]] == c) in[c] += 1.0;
+        }
+        for (int c = 0; c < r.count; ++c)
+            r.modularity += in[c] / m2 - (tot[c] / m2) * (tot[c] / m2);
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Spatial grid
+// ---------------------------------------------------------------
+
+GridCells gridCells(const QVector<QPointF>& points, const QVector<bool>& include, double cellSize)
+{
+    GridCells r;
+    r.cellOf.fill(-1, points.size());
+    if (cellSize <= 0.0) return r;
+
+    QHash<quint64, int> index;
+    index.reserve(qMin(points.size(), 1 << 16));
+    for (int i = 0; i < points.size(); ++i) {
+        if (!include.isEmpty() && !include[i]) continue;
+        const qint32 cx = qint32(std::floor(points[i].x() / cellSize));
+        const qint32 cy = qint32(std::floor(points[i].y() / cellSize));
+        const quint64 key = (quint64(quint32(cx)) << 32) | quint32(cy);
+
+        auto it = index.find(key);
+        if (it == index.end()) {
+            it = index.insert(key, r.coords.size());
+            r.coords.append(QPoint(cx, cy));
+            r.sizes.append(0);
+        }
+        r.cellOf[i] = it.value();
+        ++r.sizes[it.value()];
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------
+// Quotient edges
+// ---------------------------------------------------------------
+
+QVector<QuotientEdge> aggregateQuotientEdges(const DataHandler& dataHandler, const QVector<int>& frontOf, bool directed)
+{
+    const QVector<NodeInfo>& nodes = *dataHandler.getAllNodes();
+    const QVector<EdgeInfo>& arcs = *dataHandler.getAllEdges();
+    const int N = nodes.size();
+
+    auto frontId = [&](int v) { return v < frontOf.size() ? frontOf[v] : NO_FRONT; };
+
+    // an arc is kept when it crosses front nodes. an undirected edge is counted from its
+    // lower end, one stored in a single direction is counted from wherever it is
+    auto keep = [&](int u, int v, int fu, int fv) {
+        if (fu == NO_FRONT || fv == NO_FRONT || fu == fv) return false;
+        if (!dataHandler.nodeExists(v)) return false;
+        return directed || u < v || !dataHandler.edgeExists(v, u);
+    };
+
+    // count the kept arcs per node, then each node writes its keys into its own slice
+    QVector<int> start(N + 1, 0);
+    parallelFor(N, 1024, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            const int fu = frontId(u);
+            if (!dataHandler.nodeExists(u) || fu == NO_FRONT) continue;
+            const NodeInfo& n = nodes[u];
+            int kept = 0;
+            for (int i = n.edge_index; i < n.edge_index + n.degree; ++i)
+                if (keep(u, arcs[i].destination, fu, frontId(arcs[i].destination))) ++kept;
+            start[u + 1] = kept;
+        }
+    });
+    for (int u = 0; u < N; ++u) start[u + 1] += start[u];
+
+    // key packs the two front ids as unsigned halves, arc index rides along for the label
+    QVector<QPair<quint64, int>> keys(start[N]);
+    parallelFor(N, 1024, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            int out = start[u];
+            if (out == start[u + 1]) continue;
+            const int fu = frontId(u);
+            const NodeInfo& n = nodes[u];
+            for (int i = n.edge_index; i < n.edge_index + n.degree; ++i) {
+                const int v = arcs[i].destination;
+                const int fv = frontId(v);
+                if (!keep(u, v, fu, fv)) continue;
+                const int a = directed ? fu : qMin(fu, fv);
+                const int b = directed ? fv : qMax(fu, fv);
+                keys[out++] = qMakePair((quint64(quint32(a)) << 32) | quint32(b), i);
+            }
+        }
+    });
+    parallelSort(keys);
+
+    // equal keys are adjacent now, each run is one drawn edge
+    QVector<QuotientEdge> result;
+    for (int i = 0; i < keys.size();) {
+        int j = i + 1;
+        while (j < keys.size() && keys[j].first == keys[i].first) ++j;
+        const quint64 key = keys[i].first;
+        result.append({ int(quint32(key >> 32)), int(quint32(key)), j - i, keys[i].second });
+        i = j;
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------
+// AltOracle
+// ---------------------------------------------------------------
+
+void AltOracle::build(const CsrGraph& graph, quint64 revision, int landmarkCount,
+                      LandmarkStrategy strategy, bool symmetric)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+    m_graph = graph;
+    m_revision = revision;
+    m_symmetric = symmetric;
+
+    const int N = m_graph.nodeCount;
+    const double INF = std::numeric_limits<double>::infinity();
+
+    QVector<int> aliveIds;
+    for (int v = 0; v < N; ++v)
+        if (m_graph.alive[v]) aliveIds.append(v);
+    const int k = qMin(landmarkCount, aliveIds.size());
+
+    // copy one finished search into row l of a distance table
+    auto storeRow = [N](QVector<double>& table, int l, const QVector<double>& dist) {
+        std::copy(dist.begin(), dist.end(), table.begin() + (qint64)l * N);
+    };
+
+    if (strategy == LandmarkStrategy::HighestDegree) {
+        // top-k by degree
+        std::partial_sort(aliveIds.begin(), aliveIds.begin() + k, aliveIds.end(),
+                          [this](int a, int b) { return m_graph.degree(a) > m_graph.degree(b); });
+        m_landmarks = QVector<int>(aliveIds.begin(), aliveIds.begin() + k);
+    } else if (k > 0) {
+        // farthest point: start at the highest degree node, then repeatedly take the
+        // node farthest in hops from every landmark so far. unreachable counts as
+        // farthest so each component gets a landmark. each pick needs the previous
+        // one, so the picks use a BFS that only walks where a node gets closer
+        int next = *std::max_element(aliveIds.begin(), aliveIds.end(),
+                                     [this](int a, int b) { return m_graph.degree(a) < m_graph.degree(b); });
+        QVector<int> nearest(N, INT_MAX);
+        QVector<bool> isLandmark(N, false);
+        QVector<int> queue;
+
+        for (int l = 0; l < k; ++l) {
+            m_landmarks.append(next);
+            isLandmark[next] = true;
+            nearest[next] = 0;
+            queue.clear();
+            queue.append(next);
+            for (int qi = 0; qi < queue.size(); ++qi) {
+                const int u = queue[qi];
+                for (int i = m_graph.offsets[u]; i < m_graph.offsets[u + 1]; ++i) {
+                    const int v = m_graph.targets[i];
+                    if (!m_graph.alive[v] || nearest[u] + 1 >= nearest[v]) continue;
+                    nearest[v] = nearest[u] + 1;
+                    queue.append(v);
+                }
+            }
+
+            int best = -1;
+            for (int v : aliveIds) {
+                if (isLandmark[v]) continue;
+                if (nearest[v] > best) { best = nearest[v]; next = v; }
+            }
+        }
+    }
+
+    // the weighted rows are independent, forward d(L, v) and on directed graphs the
+    // backward d(v, L) as a forward search on the reversed graph, all in one loop.
+    // symmetric graphs (undirected) reuse the forward rows as backward ones
+    m_from.fill(INF, qsizetype(k) * N);
+    const int searches = symmetric ? k : 2 * k;
+    CsrGraph reverse;
+    if (!symmetric) {
+        m_to.fill(INF, qsizetype(k) * N);
+        reverse = m_graph.reversed();
+    }
+    parallelFor(searches, 1, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            if (i < k) storeRow(m_from, i, dijkstraSearch(m_graph, m_landmarks[i]).dist);
+            else storeRow(m_to, i - k, dijkstraSearch(reverse, m_landmarks[i - k]).dist);
+        }
+    });
+    if (symmetric) m_to = m_from;
+    m_searches = searches;
+    m_threads = searches > 0 ? parallelWorkers(searches) : 0;
+
+    m_built = true;
+    m_buildNs = timer.nsecsElapsed();
+}
+
+void AltOracle::clear()
+{
+    m_graph = CsrGraph();
+    m_landmarks.clear();
+    m_from.clear();
+    m_to.clear();
+    m_built = false;
+    m_buildNs = 0;
+    m_searches = 0;
+    m_threads = 0;
+}
+
+// best triangle inequality bound over all landmarks, infinite terms carry no information
+double AltOracle::lowerBound(int v, int target) const
+{
+    const int N = m_graph.nodeCount;
+    const double INF = std::numeric_limits<double>::infinity();
+    double best = 0.0;
+
+    for (int l = 0; l < m_landmarks.size(); ++l) {
+        const qint64 row = (qint64)l * N;
+
+        const double fromT = m_from[row + target];
+        const double fromV = m_from[row + v];
+        if (fromT != INF && fromV != INF) best = qMax(best, fromT - fromV);
+
+        const double toV = m_to[row + v];
+        const double toT = m_to[row + target];
+        if (toV != INF && toT != INF) best = qMax(best, toV - toT);
+    }
+    return best;
+}
+
+// A* on the stored snapshot with the landmark bound as heuristic
+ShortestPathResult AltOracle::query(int source, int target) const
+{
+    return heapSearch(m_graph, source, target,
+                      [this, target](int v) { return lowerBound(v, target); }, true);
+}
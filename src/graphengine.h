@@ -0,0 +1,583 @@
+#ifndef GRAPHENGINE_H
+#define GRAPHENGINE_H
+
+#include <QVector>
+#include <QString>
+#include <QPair>
+#include <QPoint>
+#include <QPointF>
+#include <limits>
+#include <functional>
+#include <QtAlgorithms>
+#include "datahandler.h"
+
+// ---------------------------------------------------------------
+// Parallel helper
+// ---------------------------------------------------------------
+
+// number of worker threads parallelFor will use for count items
+int parallelWorkers(int count);
+
+// run body(begin, end, worker) over [0, count) on a pool of std::threads.
+// workers pull chunks of grain items from a shared counter so uneven work
+// balances out, worker is in [0, parallelWorkers(count)) for per-thread buffers
+void parallelFor(int count, int grain, const std::function<void(int begin, int end, int worker)>& body);
+
+// ---------------------------------------------------------------
+// CsrGraph
+// ---------------------------------------------------------------
+
+// read-only snapshot of the backend adjacency in compressed sparse row form.
+// the DataHandler edge array has gaps between node blocks, this packs them
+// and parses the edge labels into weights once instead of per relaxation
+struct CsrGraph {
+    int nodeCount = 0;          // number of node slots, includes removed ids
+    QVector<int> offsets;       // edges of u are [offsets[u], offsets[u+1])
+    QVector<int> targets;       // destination of each edge, sorted per node
+    QVector<double> weights;    // numeric edge label, 1 if empty or non-numeric
+    QVector<bool> alive;        // false for recycled/removed node ids
+
+    bool allNumeric = true;     // every non-empty label parsed as a number
+    bool hasNegative = false;   // at least one edge weight is < 0
+
+    static CsrGraph fromDataHandler(const DataHandler& dataHandler);
+
+    // same graph with every edge flipped, for searches towards a node
+    CsrGraph reversed() const;
+
+    // undirected simple view: out and in lists merged per node, duplicates,
+    // self loops and edges to removed nodes dropped, weights kept as the
+    // smallest parallel weight. identity in shape for an undirected graph
+    CsrGraph symmetrized() const;
+
+    int edgeCount() const { return targets.size(); }
+    int degree(int u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+// ---------------------------------------------------------------
+// IndexedMinHeap
+// ---------------------------------------------------------------
+
+// binary min-heap stored in flat arrays with a position index per node,
+// so decrease-key is an in-place sift instead of a duplicate push
+class IndexedMinHeap {
+public:
+    void reset(int nodeCount);
+
+    bool isEmpty() const { return m_heap.isEmpty(); }
+    int size() const { return m_heap.size(); }
+    bool contains(int node) const { return m_pos[node] != -1; }
+    double key(int node) const { return m_key[node]; }
+    double minKey() const { return m_key[m_heap[0]]; }
+
+    // insert a node, or lower its key if it is already in the heap
+    void push(int node, double key);
+    int popMin();
+
+    // empty the heap touching only the nodes still in it, for repeated local searches
+    void clear();
+
+private:
+    QVector<int> m_heap;    // heap slots -> node ids
+    QVector<int> m_pos;     // node id -> heap slot, -1 if not in heap
+    QVector<double> m_key;  // node id -> key
+
+    void siftUp(int slot);
+    void siftDown(int slot);
+};
+
+// ---------------------------------------------------------------
+// Heap search (Dijkstra / A*)
+// ---------------------------------------------------------------
+
+struct ShortestPathResult {
+    QVector<double> dist;   // tentative distance per node slot, inf if unreached
+    QVector<int> prev;      // predecessor on the shortest path tree, -1 for none
+    int settled = 0;        // nodes popped from the heap (expanded)
+    bool reachedTarget = false;
+    QVector<int> negativeCycle;  // label-correcting search only, a cycle reachable from the source
+
+    QVector<int> pathTo(int target) const;
+};
+
+// label-setting search over the CSR with a node heuristic h(v) <= d(v, target).
+// h == 0 gives Dijkstra. with reopen set, nodes that improve after being settled
+// go back into the heap so the result stays exact for admissible but
+// inconsistent heuristics (only safe without negative weights)
+template <typename Heuristic>
+ShortestPathResult heapSearch(const CsrGraph& g, int source, int target, Heuristic h, bool reopen = false)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+
+    ShortestPathResult r;
+    r.dist.fill(INF, g.nodeCount);
+    r.prev.fill(-1, g.nodeCount);
+    if (source < 0 || source >= g.nodeCount || !g.alive[source]) return r;
+
+    QVector<bool> closed(g.nodeCount, false);
+    IndexedMinHeap heap;
+    heap.reset(g.nodeCount);
+
+    r.dist[source] = 0.0;
+    heap.push(source, h(source));
+
+    while (!heap.isEmpty()) {
+        const int u = heap.popMin();
+        closed[u] = true;
+        ++r.settled;
+
+        if (u == target) { r.reachedTarget = true; break; }
+
+        const double du = r.dist[u];
+        for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            const int v = g.targets[i];
+            if (!g.alive[v] || (closed[v] && !reopen)) continue;
+
+            const double alt = du + g.weights[i];
+            if (alt < r.dist[v]) {
+                r.dist[v] = alt;
+                r.prev[v] = u;
+                closed[v] = false;
+                heap.push(v, alt + h(v));
+            }
+        }
+    }
+    return r;
+}
+
+inline ShortestPathResult dijkstraSearch(const CsrGraph& g, int source, int target = -1)
+{
+    return heapSearch(g, source, target, [](int) { return 0.0; });
+}
+
+// ---------------------------------------------------------------
+// Bellman-Ford (SPFA)
+// ---------------------------------------------------------------
+
+// label-correcting search for graphs with negative weights: queue-based Bellman-Ford
+// (SPFA) with Tarjan's subtree disassembly. when d(v) improves, v's old subtree is cut
+// out of the shortest path tree and its queued nodes are skipped, and if that subtree
+// holds the node being scanned the improvement closed a negative cycle. the search stops
+// there and returns the cycle, otherwise it ends as soon as the queue drains
+ShortestPathResult spfaSearch(const CsrGraph& g, int source, int target = -1);
+
+// ---------------------------------------------------------------
+// Multi-source BFS
+// ---------------------------------------------------------------
+
+// sources per sweep, one bit of a quint64 each
+const int MSBFS_WIDTH = 64;
+
+// per-node bit masks reused across batches, one per worker thread
+struct MsBfsScratch {
+    QVector<quint64> seen;      // bit i set once source i has reached the node
+    QVector<quint64> visit;     // frontier of the current level
+    QVector<quint64> next;      // frontier of the next level
+    QVector<int> frontier;      // nodes with a non-zero visit mask
+    QVector<int> nextFrontier;
+
+    void reset(int nodeCount) {
+        seen.fill(0, nodeCount);
+        visit.fill(0, nodeCount);
+        next.fill(0, nodeCount);
+        frontier.clear();
+        nextFrontier.clear();
+    }
+};
+
+// up to 64 unweighted BFS traversals sharing one sweep over the CSR: a node is
+// read once per level for every source that has it in its frontier, and the
+// neighbour loop ORs whole masks instead of pushing one queue entry per source.
+// visit(node, mask, depth) is called once per node and level, mask holds bit i
+// for every source i that first reaches node at depth (sources report depth 0)
+template <typename Visitor>
+void multiSourceBfs(const CsrGraph& g, const int* sources, int count, MsBfsScratch& s, Visitor visit)
+{
+    if (s.seen.size() != g.nodeCount) s.reset(g.nodeCount);
+    count = qMin(count, MSBFS_WIDTH);
+
+    // only the masks this batch touches are non-zero, clear them on the way out
+    QVector<int> touched;
+    for (int i = 0; i < count; ++i) {
+        const int src = sources[i];
+        if (src < 0 || src >= g.nodeCount || !g.alive[src]) continue;
+        if (!s.seen[src]) { s.frontier.append(src); touched.append(src); }
+        s.seen[src] |= quint64(1) << i;
+        s.visit[src] |= quint64(1) << i;
+    }
+    for (int v : s.frontier) visit(v, s.visit[v], 0);
+
+    int depth = 0;
+    while (!s.frontier.isEmpty()) {
+        ++depth;
+
+        // push every frontier mask to the neighbours
+        for (int u : s.frontier) {
+            const quint64 mask = s.visit[u];
+            for (int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+                const int v = g.targets[i];
+                if (!g.alive[v]) continue;
+                if ((mask & ~s.seen[v]) == 0) continue;
+                if (!s.next[v]) s.nextFrontier.append(v);
+                s.next[v] |= mask;
+            }
+        }
+        for (int u : s.frontier) s.visit[u] = 0;
+        s.frontier.clear();
+
+        // keep only sources that had not reached the node yet
+        for (int v : s.nextFrontier) {
+            const quint64 fresh = s.next[v] & ~s.seen[v];
+            s.next[v] = 0;
+            if (!fresh) continue;
+            if (!s.seen[v]) touched.append(v);
+            s.seen[v] |= fresh;
+            s.visit[v] = fresh;
+            s.frontier.append(v);
+            visit(v, fresh, depth);
+        }
+        s.nextFrontier.clear();
+    }
+
+    for (int v : touched) s.seen[v] = 0;
+}
+
+// hop distance summary of one BFS source
+struct HopStats {
+    qint64 distanceSum = 0;  // sum of hop distances to every reached node
+    int reached = 0;         // reached nodes, the source included
+    int eccentricity = 0;    // largest hop distance to a reached node
+};
+
+// runs the sources in batches of 64, batches spread over parallelFor workers
+QVector<HopStats> multiSourceHopStats(const CsrGraph& g, const QVector<int>& sources);
+
+// ---------------------------------------------------------------
+// Diameter, radius and eccentricities
+// ---------------------------------------------------------------
+
+// plain array BFS: dist holds hops or -1 and order the nodes in visiting order.
+// dist must start all -1, the entries listed in order are reset before the next run
+// so repeated calls cost O(reached) instead of O(N). returns the source eccentricity
+int bfsDistances(const CsrGraph& g, int source, QVector<int>& dist, QVector<int>& order);
+
+struct DiameterResult {
+    int diameter = 0;
+    int lowerBound = 0;      // 4-sweep bound iFUB started from
+    int from = -1, to = -1;  // ends of a longest shortest path
+    int bfsRuns = 0;
+    int componentSize = 0;
+};
+
+// exact diameter of the largest component of the undirected view. a 4-sweep gives a
+// lower bound and a central start u, then iFUB takes the BFS levels of u from the
+// outside in and stops once the bound beats twice the level below
+DiameterResult ifubDiameter(const CsrGraph& g);
+
+struct EccentricityResult {
+    QVector<int> eccentricity;   // exact, or -1 where pruning showed it cannot matter or outside the component
+    int radius = 0;
+    int diameter = 0;
+    QVector<int> centre;         // nodes with eccentricity == radius
+    QVector<int> periphery;      // nodes with eccentricity == diameter
+    int bfsRuns = 0;
+    int componentSize = 0;
+};
+
+// bound pruning on the largest component of the undirected view: a BFS from v gives
+// every w max(d, ecc(v) - d) <= ecc(w) <= ecc(v) + d. BFS sources alternate between the
+// smallest lower and largest upper bound, and a node is dropped once its bounds meet or
+// it can neither be central (lower > radius bound) nor peripheral (upper < diameter bound)
+EccentricityResult eccentricityBounds(const CsrGraph& g);
+
+// ---------------------------------------------------------------
+// HyperANF (approximate neighbourhood function)
+// ---------------------------------------------------------------
+
+struct NeighbourhoodFunction {
+    QVector<double> pairs;           // N(t): estimated pairs (u, v) with d(u, v) <= t, index t from 0
+    double averageDistance = 0.0;    // over reachable pairs u != v
+    double effectiveDiameter = 0.0;  // interpolated 90th percentile of those distances
+    int registers = 0;               // HyperLogLog registers per node
+    double relativeError = 0.0;      // standard error of each counter, 1.04 / sqrt(registers)
+    bool converged = false;          // no counter changed in the last pass
+};
+
+// one HyperLogLog counter of 2^log2Registers byte registers per node, seeded with the
+// node itself. pass t+1 sets every counter to the register-wise max of its own and its
+// out-neighbours' counters from pass t, so it counts the ball of radius t+1. passes run
+// over parallelFor with double buffered rows, memory is 2 * N * 2^log2Registers bytes
+NeighbourhoodFunction hyperAnf(const CsrGraph& g, int log2Registers = 6, int maxIterations = 64);
+
+// ---------------------------------------------------------------
+// Betweenness centrality (Brandes)
+// ---------------------------------------------------------------
+
+struct BetweennessResult {
+    QVector<double> score;    // per node slot, 0 for removed ids
+    QVector<double> stdError; // per node standard error of a sampled estimate, 0 when exact
+    int sources = 0;          // single-source passes that were run
+    bool sampled = false;
+};
+
+// Brandes dependency accumulation from every source, or from sampleCount
+// sources picked uniformly without replacement and scaled by N / k. sources
+// are split over parallelFor workers that each keep their own search arrays
+// and score accumulators, summed once at the end. weighted uses Dijkstra on
+// the edge weights (must be >= 0), otherwise BFS hop counts. undirected graphs
+// see every pair from both ends, halveScores divides that back out
+BetweennessResult betweennessCentrality(const CsrGraph& g, bool weighted, bool halveScores,
+                                        int sampleCount = 0, quint32 seed = 1);
+
+// ---------------------------------------------------------------
+// PageRank / eigenvector centrality (power iteration)
+// ---------------------------------------------------------------
+
+struct PowerIterationResult {
+    QVector<double> score;  // per node slot, 0 for removed ids
+    int iterations = 0;
+    double residual = 0.0;  // L1 change of the last iteration
+    bool converged = false;
+};
+
+// pull-based SpMV over the reversed CSR: each node sums float contributions
+// of its in-neighbours, so workers write disjoint ranges and need no atomics.
+// rank of dangling nodes (no out edges) is spread by the personalisation
+// vector, which is uniform when empty. stops once the L1 residual < tolerance
+PowerIterationResult pageRank(const CsrGraph& g, double damping, const QVector<double>& personalisation,
+                              double tolerance, int maxIterations);
+
+// principal eigenvector of the adjacency matrix (in-edges), iterated on A + I
+// so bipartite graphs converge too, normalised to unit L2 length
+PowerIterationResult eigenvectorCentrality(const CsrGraph& g, double tolerance, int maxIterations);
+
+// ---------------------------------------------------------------
+// Triangles and clustering coefficient
+// ---------------------------------------------------------------
+
+struct TriangleResult {
+    QVector<qint64> perNode;     // triangles through each node
+    QVector<double> clustering;  // local clustering coefficient, 0 below degree 2
+    qint64 triangles = 0;
+    double transitivity = 0.0;   // 3 * triangles / connected triples
+    double averageClustering = 0.0;
+};
+
+// triangles on the undirected simple view. every edge is oriented from the
+// lower to the higher (degree, id) end so each node keeps at most sqrt(2E)
+// out neighbours, and each triangle is found once by merging two sorted
+// oriented lists. nodes are split over parallelFor with per-worker counters
+TriangleResult countTriangles(const CsrGraph& g);
+
+// ---------------------------------------------------------------
+// k-core decomposition
+// ---------------------------------------------------------------
+
+// core number of every node of the undirected simple view, -1 for removed ids.
+// Batagelj-Zaversnik: nodes bucketed by degree and peeled in increasing order,
+// each neighbour moved down one bucket in O(1), O(N + E) overall
+QVector<int> coreNumbers(const CsrGraph& g);
+
+// same result computed in parallel: every node repeatedly takes the h-index
+// of its neighbours' current estimates, starting from the degree, until no
+// estimate changes. rounds receives the number of sweeps
+QVector<int> coreNumbersParallel(const CsrGraph& g, int* rounds = nullptr);
+
+// ---------------------------------------------------------------
+// Strongly connected components
+// ---------------------------------------------------------------
+
+struct SccResult {
+    QVector<int> component;   // per node slot, -1 for removed ids
+    int count = 0;
+    QVector<int> sizes;       // nodes per component
+
+    // condensation DAG over component ids, numbered in topological order
+    // (every DAG edge goes from a lower to a higher id), parallel edges merged
+    QVector<int> dagOffsets;
+    QVector<int> dagTargets;
+};
+
+// Tarjan's algorithm with an explicit call stack of (node, next edge) frames,
+// so chains of millions of nodes cannot overflow the thread stack. O(N + E)
+SccResult stronglyConnectedComponents(const CsrGraph& g);
+
+// ---------------------------------------------------------------
+// Articulation points, bridges, biconnected components
+// ---------------------------------------------------------------
+
+struct BiconnectedResult {
+    QVector<bool> articulation;        // per node slot, cut vertices
+    QVector<QPair<int,int>> bridges;   // (u, v) with u < v
+    QVector<int> blocksPerNode;        // blocks containing each node, > 1 exactly for cut vertices
+
+    // members of each biconnected block in CSR form, a bridge is a block of two
+    QVector<int> blockOffsets;
+    QVector<int> blockNodes;
+    int blockCount() const { return blockOffsets.isEmpty() ? 0 : blockOffsets.size() - 1; }
+};
+
+// Hopcroft-Tarjan on the undirected view of the graph (edge direction ignored).
+// explicit (node, next edge) frames plus an edge stack that is cut into blocks
+// whenever low[child] >= disc[parent], no recursion. O(N + E)
+BiconnectedResult biconnectedComponents(const CsrGraph& g);
+
+// ---------------------------------------------------------------
+// Minimum spanning forest
+// ---------------------------------------------------------------
+
+enum class MstMethod { Auto, Kruskal, Boruvka };
+
+struct SpanningForestResult {
+    QVector<QPair<int,int>> edges;   // (u, v) with u < v
+    QVector<double> weights;         // parallel to edges
+    double totalWeight = 0.0;
+    int trees = 0;                   // one per connected component, isolated nodes included
+    MstMethod method = MstMethod::Kruskal;
+    int rounds = 0;                  // Boruvka contraction rounds, 0 for Kruskal
+};
+
+// minimum spanning forest of the undirected view, antiparallel edges keep the lighter
+// weight. ties are broken by (weight, u, v) so both methods return the same forest.
+// Kruskal sorts the edge list in parallel chunks and merges them, Boruvka lets every
+// component pick its lightest outgoing edge in parallel and hooks them each round.
+// Auto picks Kruskal below MST_BORUVKA_EDGES edges
+constexpr int MST_BORUVKA_EDGES = 200000;
+SpanningForestResult minimumSpanningForest(const CsrGraph& g, MstMethod method = MstMethod::Auto);
+
+// ---------------------------------------------------------------
+// Maximum flow / minimum cut
+// ---------------------------------------------------------------
+
+struct MaxFlowResult {
+    double value = 0.0;
+    QVector<bool> sourceSide;            // per node slot, nodes that cannot reach the sink in the residual graph
+    QVector<QPair<int,int>> cutEdges;    // original edges from the source side to the sink side
+    QVector<double> cutCapacities;       // parallel to cutEdges, they sum to value
+    int pushes = 0;
+    int relabels = 0;
+    int globalRelabels = 0;
+    int gapNodes = 0;                    // nodes lifted out of play by the gap heuristic
+};
+
+// highest-label push-relabel on a residual graph with a paired reverse arc per edge.
+// edge weights are capacities, negatives count as 0. global relabelling is a reverse BFS
+// from the sink, rerun after O(N + E) relabel work, and an emptied height lifts every
+// node above it out of play. only the preflow phase runs since the value and the cut
+// are known once no active node can reach the sink
+MaxFlowResult maxFlowMinCut(const CsrGraph& g, int source, int sink);
+
+// ---------------------------------------------------------------
+// Community detection (Louvain)
+// ---------------------------------------------------------------
+
+struct CommunityResult {
+    QVector<int> community;            // per node slot, -1 for removed ids, 0 is the largest community
+    int count = 0;
+    QVector<int> sizes;                // nodes per community, decreasing
+    double modularity = 0.0;
+    QVector<double> levelModularity;   // after the local moving of each level
+    int levels = 0;
+    int sweeps = 0;                    // label propagation passes
+    bool converged = false;            // label propagation stopped because no label changed
+};
+
+// Louvain on the undirected view with unit edge weights. local moving evaluates every
+// node in parallel against a snapshot of the community totals and applies the moves
+// between slices of a hashed node split, so neighbours rarely move at the same time.
+// a move between two singletons only goes towards the lower id, which stops them
+// swapping back and forth. each level is then aggregated into a community graph by
+// sorting packed (community, community) keys, until no node moves
+CommunityResult louvainCommunities(const CsrGraph& g, double resolution = 1.0);
+
+// asynchronous label propagation on the undirected view: every node takes the label
+// most common among its neighbours (random tie-break, its own label wins a tie),
+// reading and writing labels in place while other workers do the same. each sweep
+// visits the nodes in a fresh random order and the run stops once a sweep changes
+// nothing or after maxSweeps. near linear, but lower quality than Louvain
+CommunityResult labelPropagation(const CsrGraph& g, int maxSweeps = 20, quint32 seed = 1);
+
+// ---------------------------------------------------------------
+// Spatial grid
+// ---------------------------------------------------------------
+
+struct GridCells {
+    QVector<int> cellOf;        // cell index per point, -1 where the point was left out
+    QVector<QPoint> coords;     // column and row of each occupied cell, in first-seen order
+    QVector<int> sizes;         // points per cell
+    int count() const { return coords.size(); }
+};
+
+// buckets points into square cells of cellSize, cell (c, r) covers
+// [c * cellSize, (c + 1) * cellSize) x [r * cellSize, (r + 1) * cellSize).
+// one hashed pass over a packed (column, row) key, an empty include takes every point
+GridCells gridCells(const QVector<QPointF>& points, const QVector<bool>& include, double cellSize);
+
+// ---------------------------------------------------------------
+// Quotient edges
+// ---------------------------------------------------------------
+
+constexpr int NO_FRONT = std::numeric_limits<int>::min();   // frontOf entry for backend ids that are not drawn
+
+// one drawn edge between two front nodes, standing for count backend edges
+struct QuotientEdge {
+    int src;
+    int dst;        // src < dst when undirected
+    int count;
+    int arc;        // index into DataHandler::getAllEdges() of one of the edges, for its label
+};
+
+// aggregate the backend edges by the front node of each endpoint. every arc is mapped
+// to a 64-bit (frontSrc, frontDst) key in parallel, the keys are sorted and equal runs
+// collapse into one edge. undirected edges are counted once, edges inside a front node
+// and edges touching NO_FRONT are dropped. result is sorted by key
+QVector<QuotientEdge> aggregateQuotientEdges(const DataHandler& dataHandler, const QVector<int>& frontOf, bool directed);
+
+// ---------------------------------------------------------------
+// AltOracle (A*, landmarks, triangle inequality)
+// ---------------------------------------------------------------
+
+enum class LandmarkStrategy { FarthestPoint, HighestDegree };
+
+// precomputed distances from and to k landmark nodes. for any landmark L,
+// d(v,t) >= d(L,t) - d(L,v) and d(v,t) >= d(v,L) - d(t,L), the best of these
+// bounds is the A* heuristic. the oracle keeps its own CSR snapshot and the
+// DataHandler revision it was built at so stale data is never queried
+class AltOracle {
+public:
+    // picks landmarks and runs the 2k Dijkstra searches in parallel.
+    // symmetric graphs (undirected) reuse the forward arrays as backward ones,
+    // so only k searches run
+    void build(const CsrGraph& graph, quint64 revision, int landmarkCount,
+               LandmarkStrategy strategy, bool symmetric);
+    void clear();
+
+    bool isValid(quint64 revision, bool symmetric) const {
+        return m_built && m_revision == revision && m_symmetric == symmetric;
+    }
+
+    const CsrGraph& graph() const { return m_graph; }
+    const QVector<int>& landmarks() const { return m_landmarks; }
+    qint64 buildNsecs() const { return m_buildNs; }
+    int searches() const { return m_searches; }   // Dijkstra searches the last build ran
+    int threads() const { return m_threads; }     // workers those searches were spread over
+
+    // lower bound on d(v, target) from the stored landmark distances
+    double lowerBound(int v, int target) const;
+
+    ShortestPathResult query(int source, int target) const;
+
+private:
+    CsrGraph m_graph;
+    QVector<int> m_landmarks;
+    QVector<double> m_from;   // m_from[l * N + v] = d(landmark l, v)
+    QVector<double> m_to;     // m_to[l * N + v]   = d(v, landmark l)
+    quint64 m_revision = 0;
+    bool m_symmetric = true;
+    bool m_built = false;
+    qint64 m_buildNs = 0;
+    int m_searches = 0;
+    int m_threads = 0;
+};
+
+#endif // GRAPHENGINE_H
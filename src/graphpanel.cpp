@@ -9,6 +9,8 @@
 #include <QSplitter>
 #include <QHeaderView>
 #include <QFont>
+#include <cmath>
+#include <algorithm>
 
 // ---------------------------------------------------------------
 // Constructor
@@ -88,6 +90,12 @@ GraphPanel::GraphPanel(NetSim* netSim, const Widgets& w, QObject* parent)
                 showNodeContextMenu(pos);
             });
         }
+        // header right click colours the nodes by a metric column
+        m_w.nodeTable->horizontalHeader()->setContextMenuPolicy(Qt::CustomContextMenu);
+        connect(m_w.nodeTable->horizontalHeader(), &QHeaderView::customContextMenuRequested,
+                this, [this](const QPoint& pos) {
+            showNodeHeaderMenu(pos);
+        });
         if (m_w.edgeTable) {
             m_w.edgeTable->setContextMenuPolicy(Qt::CustomContextMenu);
             connect(m_w.edgeTable, &QTableWidget::customContextMenuRequested,
@@ -213,6 +221,31 @@ void GraphPanel::showNodeContextMenu(const QPoint& pos) {
     });
 }
 
+// node table header right click, lists the metric columns for colouring
+void GraphPanel::showNodeHeaderMenu(const QPoint& pos) {
+    QTableWidget* t = m_w.nodeTable;
+    if (!t || m_metricColumns.isEmpty()) return;
+
+    QMenu menu;
+    const int column = t->horizontalHeader()->logicalIndexAt(pos);
+    for (int i = 0; i < m_metricColumns.size(); ++i) {
+        const QString metric = m_metricColumns[i];
+        QAction* colourAction = menu.addAction(QString("Colour nodes by %1").arg(metric));
+        if (column == BASE_NODE_COLUMNS + i) menu.setDefaultAction(colourAction);
+        connect(colourAction, &QAction::triggered, this, [this, metric]() {
+            emit colourByMetricRequested(metric);
+        });
+    }
+
+    menu.addSeparator();
+    QAction* clearAction = menu.addAction("Clear node colouring");
+    connect(clearAction, &QAction::triggered, this, [this]() {
+        emit colourByMetricRequested(QString());
+    });
+
+    menu.exec(t->horizontalHeader()->viewport()->mapToGlobal(pos));
+}
+
 // edge right click table
 void GraphPanel::showEdgeContextMenu(const QPoint& pos) {
     QTableWidget* t = m_w.edgeTable;
@@ -381,6 +414,7 @@ void GraphPanel::refresh() {
     if (m_w.nodeTable) m_w.nodeTable->blockSignals(true);
     if (m_w.edgeTable) m_w.edgeTable->blockSignals(true);
 
+    syncMetricColumns();
     populateNodeTable();
     populateEdgeTable();
     updateCountLabels();
@@ -393,6 +427,13 @@ void GraphPanel::refresh() {
 void GraphPanel::clear() {
     if (m_w.nodeTable) m_w.nodeTable->setRowCount(0);
     if (m_w.edgeTable) m_w.edgeTable->setRowCount(0);
+    m_nodeIdToRow.clear();
+    m_edgeKeyToRow.clear();
+    m_nodeBatch.dropRows.clear();
+    m_nodeBatch.placeRows.clear();
+    m_edgeBatch.dropRows.clear();
+    m_edgeBatch.placeRows.clear();
+    syncMetricColumns();
     updateCountLabels();
 }
 
@@ -430,23 +471,29 @@ void GraphPanel::syncToggleButtons(bool nodesActive) {
 void GraphPanel::populateNodeTable() {
     QTableWidget* t = m_w.nodeTable;
     if (!t) return;
-    t->setSortingEnabled(false);
+    beginBatch();
     t->setRowCount(0);
+    m_nodeIdToRow.clear();
+    m_nodeBatch.dropRows.clear();
+    m_nodeBatch.placeRows.clear();
 
-    // loop through all nodes add them to the table
+    // loop through all nodes add them to the table, the batch sorts them once
     for (auto it = m_nodeItems->constBegin(); it != m_nodeItems->constEnd(); ++it) {
         int nodeId = it.key();
         addNodeRow(nodeId);
     }
-    t->setSortingEnabled(true);
+    endBatch();
 }
 
 // Populate edge table
 void GraphPanel::populateEdgeTable() {
     QTableWidget* t = m_w.edgeTable;
     if (!t) return;
-    t->setSortingEnabled(false);
+    beginBatch();
     t->setRowCount(0);
+    m_edgeKeyToRow.clear();
+    m_edgeBatch.dropRows.clear();
+    m_edgeBatch.placeRows.clear();
 
     // loop through all edge items and their edges adding them to the table
     QSet<QPair<int,int>> addedKeys;
@@ -456,8 +503,7 @@ void GraphPanel::populateEdgeTable() {
         addedKeys.insert(normKey);
         addEdgeRow(it.key().first, it.key().second);
     }
-    
-    t->setSortingEnabled(true);
+    endBatch();
 }
 
 
@@ -470,32 +516,18 @@ void GraphPanel::addNodeRow(int nodeId)
     if (!node) return;
 
     QString label;
-    int degree = 0;
-
     if (nodeId >= 0) {
         // Regular node: use backend data
         if (!m_dataHandler->nodeExists(nodeId)) return;
         label = m_dataHandler->nodeLabel(nodeId);
-        degree = m_dataHandler->getNode(nodeId)->degree;
     } else {
-        // Contracted node: aggregate from members
-        const QVector<int> members = m_netSimWindow->getMembers(nodeId);
-        label = QString("Contracted (%1 nodes)").arg(members.size());
-        // Compute degree = sum of member degrees - 2 * internal edges
-        QSet<QPair<int,int>> internalEdges;
-        for (int src : members) {
-            degree += m_dataHandler->getNode(src)->degree;
-            for (const EdgeInfo& e : m_dataHandler->getEdgesOf(src)) {
-                int dst = e.destination;
-                if (members.contains(dst) && src < dst) {
-                    internalEdges.insert({src, dst});
-                }
-            }
-        }
-        degree -= 2 * internalEdges.size();
+        label = QString("Contracted (%1 nodes)").arg(m_dataHandler->quotient().leafCount(nodeId));
     }
+    const int degree = nodeDegree(nodeId);
 
-    t->setSortingEnabled(false);
+    // appended while sorting is parked, endBatch moves it to its place
+    beginBatch();
+    parkSorting(t, m_nodeBatch);
     int row = t->rowCount();
     t->insertRow(row);
 
@@ -523,9 +555,12 @@ void GraphPanel::addNodeRow(int nodeId)
     statusItem->setFlags(statusItem->flags() & ~Qt::ItemIsEditable);
     t->setItem(row, 3, statusItem);
 
-    t->setSortingEnabled(true);
+    setNodeMetricCells(row, nodeId);
+
     m_nodeIdToRow[nodeId] = row;
-    updateCountLabels();
+    m_nodeBatch.changed = true;
+    if (m_nodeBatch.sortColumn >= 0) m_nodeBatch.placeRows.insert(row);
+    endBatch();
 }
 
 // Remove a single node row from the node table by nodeId
@@ -533,16 +568,15 @@ void GraphPanel::removeNodeRow(int nodeId) {
     QTableWidget* t = m_w.nodeTable;
     if (!t) return;
 
-    // iterate in reverse so row removal doesn't shift indices mid-loop
-    for (int row = t->rowCount() - 1; row >= 0; --row) {
-        auto* col0 = t->item(row, 0);
-        if (col0 && col0->data(Qt::UserRole).toInt() == nodeId) {
-            t->removeRow(row);
-            rebuildNodeRowIndex();
-            updateCountLabels();
-            return;
-        }
-    }
+    const int row = findNodeRow(nodeId);
+    if (row < 0) return;
+    m_nodeIdToRow.remove(nodeId);
+
+    // the row goes at endBatch so the other indexed rows don't shift
+    beginBatch();
+    m_nodeBatch.dropRows.insert(row);
+    m_nodeBatch.changed = true;
+    endBatch();
 }
 
 // Add a single edge row to the edge table
@@ -566,7 +600,8 @@ void GraphPanel::addEdgeRow(int srcId, int dstId) {
         return n ? n->getLabel() : QString("Contracted");
     };
 
-    t->setSortingEnabled(false);
+    beginBatch();
+    parkSorting(t, m_edgeBatch);
     int row = t->rowCount();
     t->insertRow(row);
 
@@ -592,9 +627,10 @@ void GraphPanel::addEdgeRow(int srcId, int dstId) {
     statusItem->setFlags(statusItem->flags() & ~Qt::ItemIsEditable);
     t->setItem(row, 3, statusItem);
 
-    t->setSortingEnabled(true);
-    m_edgeKeyToRow[normKey] = m_w.edgeTable->rowCount() - 1;
-    updateCountLabels();
+    m_edgeKeyToRow[normKey] = row;
+    m_edgeBatch.changed = true;
+    if (m_edgeBatch.sortColumn >= 0) m_edgeBatch.placeRows.insert(row);
+    endBatch();
 }
 
 // Remove a single edge row from the edge table by src/dst ids
@@ -604,35 +640,200 @@ void GraphPanel::removeEdgeRow(int srcId, int dstId) {
 
     // normalize key to match how it was stored when the row was added
     QPair<int,int> key = {qMin(srcId, dstId), qMax(srcId, dstId)};
+    const int row = findEdgeRow(key);
+    if (row < 0) return;
+    m_edgeKeyToRow.remove(key);
+
+    beginBatch();
+    m_edgeBatch.dropRows.insert(row);
+    m_edgeBatch.changed = true;
+    endBatch();
+}
+
+// row of a node, the index is checked against the row's id and a scan covers a stale entry
+int GraphPanel::findNodeRow(int nodeId) const {
+    QTableWidget* t = m_w.nodeTable;
+    const int indexed = m_nodeIdToRow.value(nodeId, -1);
+    if (indexed >= 0 && indexed < t->rowCount()) {
+        auto* col0 = t->item(indexed, 0);
+        if (col0 && col0->data(Qt::UserRole).toInt() == nodeId) return indexed;
+    }
+    for (int row = t->rowCount() - 1; row >= 0; --row) {
+        auto* col0 = t->item(row, 0);
+        if (col0 && col0->data(Qt::UserRole).toInt() == nodeId && !m_nodeBatch.dropRows.contains(row)) return row;
+    }
+    return -1;
+}
 
-    // iterate in reverse so row removal doesn't shift indices mid-loop
+int GraphPanel::findEdgeRow(const QPair<int,int>& key) const {
+    QTableWidget* t = m_w.edgeTable;
+    const int indexed = m_edgeKeyToRow.value(key, -1);
+    if (indexed >= 0 && indexed < t->rowCount()) {
+        auto* col0 = t->item(indexed, 0);
+        if (col0 && col0->data(Qt::UserRole).value<QPair<int,int>>() == key) return indexed;
+    }
     for (int row = t->rowCount() - 1; row >= 0; --row) {
         auto* col0 = t->item(row, 0);
-        if (col0 && col0->data(Qt::UserRole).value<QPair<int,int>>() == key) {
-            t->removeRow(row);
-            rebuildEdgeRowIndex();
-            updateCountLabels();
-            return;
+        if (col0 && col0->data(Qt::UserRole).value<QPair<int,int>>() == key && !m_edgeBatch.dropRows.contains(row)) return row;
+    }
+    return -1;
+}
+
+// backend degree for a node, arcs leaving the group for a contracted one
+int GraphPanel::nodeDegree(int nodeId) const {
+    if (nodeId >= 0) return m_dataHandler->getNode(nodeId)->degree;
+
+    int degree = 0;
+    const QHash<int,int> out = m_dataHandler->quotient().outArcs(nodeId);
+    for (auto it = out.cbegin(); it != out.cend(); ++it) degree += it.value();
+    return degree;
+}
+
+// ---------------------------------------------------------------
+// Batched row edits
+// ---------------------------------------------------------------
+void GraphPanel::beginBatch() {
+    if (m_batchDepth++ > 0) return;
+
+    for (QTableWidget* t : { m_w.nodeTable, m_w.edgeTable })
+        if (t) t->blockSignals(true);
+}
+
+void GraphPanel::endBatch() {
+    if (m_batchDepth == 0 || --m_batchDepth > 0) return;
+
+    const int nodeLow = finishBatch(m_w.nodeTable, m_nodeBatch);
+    const int edgeLow = finishBatch(m_w.edgeTable, m_edgeBatch);
+    for (QTableWidget* t : { m_w.nodeTable, m_w.edgeTable })
+        if (t) t->blockSignals(false);
+
+    // rows above the lowest moved one kept their index entries
+    if (nodeLow >= 0) rebuildNodeRowIndex(nodeLow);
+    if (edgeLow >= 0) rebuildEdgeRowIndex(edgeLow);
+    if (nodeLow >= 0 || edgeLow >= 0) updateCountLabels();
+}
+
+// stop QTableWidget from moving rows as their cells are set. toggling setSortingEnabled
+// would re-sort the whole table when turned back on, so only the indicator is cleared
+// with the header quiet and put back the same way in finishBatch
+void GraphPanel::parkSorting(QTableWidget* t, TableBatch& b) {
+    if (b.parked) return;
+    b.parked = true;
+
+    QHeaderView* header = t->horizontalHeader();
+    b.sortColumn = t->isSortingEnabled() ? header->sortIndicatorSection() : -1;
+    b.sortOrder = header->sortIndicatorOrder();
+    if (b.sortColumn < 0) return;
+
+    header->blockSignals(true);
+    header->setSortIndicator(-1, b.sortOrder);
+    header->blockSignals(false);
+}
+
+// row key would take among the sorted rows, the same lower bound QTableWidget inserts at
+int GraphPanel::sortedRow(QTableWidget* t, const TableBatch& b, const QTableWidgetItem* key) const {
+    int lo = 0, hi = t->rowCount();
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        const QTableWidgetItem* cell = t->item(mid, b.sortColumn);
+        const bool before = cell && key && (b.sortOrder == Qt::AscendingOrder ? *cell < *key : *key < *cell);
+        if (before) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// apply one table's batch: lift the rows to place, drop them with the dead rows, then put
+// them back at their sorted rows. a few rows are removed bottom up, many slide the
+// survivors' items up and cut the tail in one pass. a batch placing more than a few rows
+// (a full populate) keeps them where they are and sorts the table once instead.
+// returns the lowest row that moved, -1 if nothing changed
+int GraphPanel::finishBatch(QTableWidget* t, TableBatch& b) {
+    auto unpark = [&]() {
+        if (t && b.parked && b.sortColumn >= 0) {
+            t->horizontalHeader()->blockSignals(true);
+            t->horizontalHeader()->setSortIndicator(b.sortColumn, b.sortOrder);
+            t->horizontalHeader()->blockSignals(false);
         }
+        b = TableBatch();
+    };
+    if (!t || !b.changed) {
+        unpark();
+        return -1;
+    }
+    parkSorting(t, b);
+
+    int low = t->rowCount();
+    int placed = 0;
+    for (int row : b.placeRows)
+        if (!b.dropRows.contains(row)) ++placed;
+    const bool resort = placed > FEW_ROWS;
+
+    QVector<QVector<QTableWidgetItem*>> lifted;
+    QSet<int> gone = b.dropRows;
+    for (int row : b.placeRows) {
+        if (resort || b.dropRows.contains(row)) continue;
+        QVector<QTableWidgetItem*> cells(t->columnCount());
+        for (int c = 0; c < cells.size(); ++c) cells[c] = t->takeItem(row, c);
+        lifted.append(cells);
+        gone.insert(row);
     }
+
+    if (!gone.isEmpty()) {
+        QVector<int> rows(gone.begin(), gone.end());
+        std::sort(rows.begin(), rows.end());
+        low = rows.first();
+        if (rows.size() <= FEW_ROWS) {
+            for (int i = rows.size() - 1; i >= 0; --i) t->removeRow(rows[i]);
+        } else {
+            int write = rows.first();
+            int next = 0;
+            for (int read = rows.first(); read < t->rowCount(); ++read) {
+                if (next < rows.size() && rows[next] == read) { ++next; continue; }
+                for (int c = 0; c < t->columnCount(); ++c)
+                    t->setItem(write, c, t->takeItem(read, c));
+                ++write;
+            }
+            t->setRowCount(write);
+        }
+    }
+
+    for (const QVector<QTableWidgetItem*>& cells : lifted) {
+        const QTableWidgetItem* key = b.sortColumn < cells.size() ? cells[b.sortColumn] : nullptr;
+        const int row = sortedRow(t, b, key);
+        t->insertRow(row);
+        for (int c = 0; c < cells.size(); ++c) t->setItem(row, c, cells[c]);
+        low = qMin(low, row);
+    }
+
+    // sortItems sets the indicator too, which would make the view sort a second time
+    if (resort) {
+        t->horizontalHeader()->blockSignals(true);
+        t->sortItems(b.sortColumn, b.sortOrder);
+        t->horizontalHeader()->blockSignals(false);
+        low = 0;
+    }
+
+    unpark();
+    return low;
 }
 
 // ---------------------------------------------------------------
 // Reverse-index builders — called after populate or sort change
 // ---------------------------------------------------------------
-void GraphPanel::rebuildNodeRowIndex() {
-    m_nodeIdToRow.clear();
+void GraphPanel::rebuildNodeRowIndex(int fromRow) {
+    if (fromRow <= 0) m_nodeIdToRow.clear();
     if (!m_w.nodeTable) return;
-    for (int row = 0; row < m_w.nodeTable->rowCount(); ++row) {
+    for (int row = qMax(fromRow, 0); row < m_w.nodeTable->rowCount(); ++row) {
         auto* col0 = m_w.nodeTable->item(row, 0);
         if (col0) m_nodeIdToRow[col0->data(Qt::UserRole).toInt()] = row;
     }
 }
 
-void GraphPanel::rebuildEdgeRowIndex() {
-    m_edgeKeyToRow.clear();
+void GraphPanel::rebuildEdgeRowIndex(int fromRow) {
+    if (fromRow <= 0) m_edgeKeyToRow.clear();
     if (!m_w.edgeTable) return;
-    for (int row = 0; row < m_w.edgeTable->rowCount(); ++row) {
+    for (int row = qMax(fromRow, 0); row < m_w.edgeTable->rowCount(); ++row) {
         auto* col0 = m_w.edgeTable->item(row, 0);
         if (col0) m_edgeKeyToRow[col0->data(Qt::UserRole).value<QPair<int,int>>()] = row;
     }
@@ -648,36 +849,26 @@ void GraphPanel::updateNodeRow(int nodeId)
     QTableWidget* t = m_w.nodeTable;
     if (!t) return;
 
-    auto it = m_nodeIdToRow.find(nodeId);
-    if (it == m_nodeIdToRow.end()) return;
-    int row = it.value();
+    const int row = findNodeRow(nodeId);
+    if (row < 0) return;
 
     NetworkNode* node = m_nodeItems->value(nodeId);
     if (!node) return;
 
     QString label;
-    int degree = 0;
-
     if (nodeId >= 0) {
         if (!m_dataHandler->nodeExists(nodeId)) return;
         label = m_dataHandler->nodeLabel(nodeId);
-        degree = m_dataHandler->getNode(nodeId)->degree;
     } else {
-        const QVector<int> members = m_netSimWindow->getMembers(nodeId);
-        label = QString("Contracted (%1 nodes)").arg(members.size());
-        QSet<QPair<int,int>> internalEdges;
-        for (int src : members) {
-            degree += m_dataHandler->getNode(src)->degree;
-            for (const EdgeInfo& e : m_dataHandler->getEdgesOf(src)) {
-                int dst = e.destination;
-                if (members.contains(dst) && src < dst)
-                    internalEdges.insert({src, dst});
-            }
-        }
-        degree -= 2 * internalEdges.size();
+        label = QString("Contracted (%1 nodes)").arg(m_dataHandler->quotient().leafCount(nodeId));
     }
+    const int degree = nodeDegree(nodeId);
 
-    t->blockSignals(true);
+    // a changed sort key moves the row at endBatch
+    beginBatch();
+    parkSorting(t, m_nodeBatch);
+    const QTableWidgetItem* sortItem = m_nodeBatch.sortColumn >= 0 ? t->item(row, m_nodeBatch.sortColumn) : nullptr;
+    const QVariant sortKey = sortItem ? sortItem->data(Qt::DisplayRole) : QVariant();
 
     if (auto* labelItem = t->item(row, 0)) {
         labelItem->setText(label);
@@ -690,8 +881,58 @@ void GraphPanel::updateNodeRow(int nodeId)
         posItem->setText(QString("(%1, %2)").arg(static_cast<int>(p.x())).arg(static_cast<int>(p.y())));
     if (auto* statusItem = t->item(row, 3))
         if (nodeId < 0) statusItem->setText("Contracted");
+    setNodeMetricCells(row, nodeId);
 
+    if (sortItem && sortItem->data(Qt::DisplayRole) != sortKey) {
+        m_nodeBatch.placeRows.insert(row);
+        m_nodeBatch.changed = true;
+    }
+    endBatch();
+}
+
+// ---------------------------------------------------------------
+// Node metric columns
+// ---------------------------------------------------------------
+
+// one numeric column per DataHandler metric after the fixed columns
+void GraphPanel::syncMetricColumns()
+{
+    QTableWidget* t = m_w.nodeTable;
+    if (!t || !m_dataHandler) return;
+
+    m_metricColumns = m_dataHandler->nodeMetricNames();
+    t->setColumnCount(BASE_NODE_COLUMNS + m_metricColumns.size());
+    for (int i = 0; i < m_metricColumns.size(); ++i)
+        t->setHorizontalHeaderItem(BASE_NODE_COLUMNS + i, new QTableWidgetItem(m_metricColumns[i]));
+}
+
+void GraphPanel::refreshMetricColumns()
+{
+    QTableWidget* t = m_w.nodeTable;
+    if (!t || !m_dataHandler) return;
+
+    syncMetricColumns();
+    t->blockSignals(true);
+    populateNodeTable();
     t->blockSignals(false);
+    rebuildNodeRowIndex();
+}
+
+// numeric items so sorting by a metric column orders by value, blank if unknown
+void GraphPanel::setNodeMetricCells(int row, int nodeId)
+{
+    QTableWidget* t = m_w.nodeTable;
+    for (int i = 0; i < m_metricColumns.size(); ++i) {
+        const double value = m_netSimWindow->nodeMetricValue(m_metricColumns[i], nodeId);
+
+        auto* item = t->item(row, BASE_NODE_COLUMNS + i);
+        if (!item) {
+            item = new QTableWidgetItem();
+            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+            t->setItem(row, BASE_NODE_COLUMNS + i, item);
+        }
+        item->setData(Qt::DisplayRole, std::isnan(value) ? QVariant() : QVariant(value));
+    }
 }
 
 // ---------------------------------------------------------------
@@ -703,10 +944,8 @@ void GraphPanel::updateEdgeRow(int srcId, int dstId) {
 
     // get the row from the normalized key
     QPair<int,int> normKey = {qMin(srcId, dstId), qMax(srcId, dstId)};
-    auto it = m_edgeKeyToRow.find(normKey);
-    if (it == m_edgeKeyToRow.end()) return;
-
-    int row = it.value();
+    const int row = findEdgeRow(normKey);
+    if (row < 0) return;
 
     NetworkEdge* edge = m_edgeItems->value(normKey, nullptr);
     if (!edge) return;
@@ -722,7 +961,11 @@ void GraphPanel::updateEdgeRow(int srcId, int dstId) {
         return n ? n->getLabel() : QString("Contracted");
     };
 
-    t->blockSignals(true);
+    beginBatch();
+    parkSorting(t, m_edgeBatch);
+    const QTableWidgetItem* sortItem = m_edgeBatch.sortColumn >= 0 ? t->item(row, m_edgeBatch.sortColumn) : nullptr;
+    const QVariant sortKey = sortItem ? sortItem->data(Qt::DisplayRole) : QVariant();
+
     if (auto* labelItem = t->item(row, 0)) {
         labelItem->setText(label);
         if (isContracted)
@@ -731,7 +974,12 @@ void GraphPanel::updateEdgeRow(int srcId, int dstId) {
     if (auto* srcItem  = t->item(row, 1)) srcItem->setText(nodeDisplayName(normKey.first));
     if (auto* dstItem  = t->item(row, 2)) dstItem->setText(nodeDisplayName(normKey.second));
     if (auto* statItem = t->item(row, 3)) statItem->setText(isContracted ? "Contracted" : "Normal");
-    t->blockSignals(false);
+
+    if (sortItem && sortItem->data(Qt::DisplayRole) != sortKey) {
+        m_edgeBatch.placeRows.insert(row);
+        m_edgeBatch.changed = true;
+    }
+    endBatch();
 }
 
 // ---------------------------------------------------------------
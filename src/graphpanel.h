@@ -5,6 +5,8 @@
 #include <QList>
 #include <QHash>
 #include <QPair>
+#include <QSet>
+#include <QVector>
 #include "datahandler.h"
 #include "netsim_classes.h"
 
@@ -14,6 +16,7 @@ class QGraphicsItem;
 class NetSim;
 class QPushButton;
 class QTableWidget;
+class QTableWidgetItem;
 class QStackedWidget;
 class QLabel;
 class QSplitter;
@@ -51,14 +54,25 @@ public:
     void removeEdgeRow(int srcId, int dstId);
     void onGraphSelectionChanged(const QList<QGraphicsItem*>& selectedItems);
     // void updateNodePositions();
-    void rebuildNodeRowIndex();
-    void rebuildEdgeRowIndex();
+    // rows before fromRow are taken as still indexed
+    void rebuildNodeRowIndex(int fromRow = 0);
+    void rebuildEdgeRowIndex(int fromRow = 0);
 
     // targeted single-row updates 
     void updateNodeRow(int nodeId); 
     void updateEdgeRow(int srcId, int dstId);
     void updateCountLabels();
 
+    // batched row edits for expand and collapse. rows stay put until endBatch, which
+    // drops the removed ones, moves the new or edited ones to their sorted place and
+    // re-indexes from the lowest moved row. single row edits are a batch of one and
+    // batches nest
+    void beginBatch();
+    void endBatch();
+
+    // rebuild the node table columns after a DataHandler node metric was set or removed
+    void refreshMetricColumns();
+
 signals:
     void tableNodesSelected(QHash<int, NetworkNode*>& nodes);
     void tableEdgesSelected(QHash<QPair<int,int>, NetworkEdge*>& edges);
@@ -67,6 +81,7 @@ signals:
     void findRequested();
     void expandRequested(int nodeId);
     void moveToOriginRequested();
+    void colourByMetricRequested(const QString& metric);
 
 private slots:
     void showNodeView();
@@ -80,9 +95,39 @@ private:
 
     void showNodeContextMenu(const QPoint& pos);
     void showEdgeContextMenu(const QPoint& pos);
+    void showNodeHeaderMenu(const QPoint& pos);
+
+    // node table columns before the metric columns: label, degree, position, contracted
+    static const int BASE_NODE_COLUMNS = 4;
+    QStringList m_metricColumns;
+    void syncMetricColumns();
+    void setNodeMetricCells(int row, int nodeId);
 
     bool m_suppressTableScroll = false;
 
+    // batches of up to this many rows are edited in place, larger ones sort once
+    static const int FEW_ROWS = 32;
+
+    // row edits of one table since the outermost beginBatch. the sort indicator is
+    // parked on the first edit so QTableWidget doesn't move rows while cells are set
+    struct TableBatch {
+        QSet<int> dropRows;             // rows to delete
+        QSet<int> placeRows;            // new or re-keyed rows to move to their sorted place
+        bool changed = false;
+        bool parked = false;
+        int sortColumn = -1;            // -1 if the table isn't sorted
+        Qt::SortOrder sortOrder = Qt::AscendingOrder;
+    };
+    int m_batchDepth = 0;
+    TableBatch m_nodeBatch;
+    TableBatch m_edgeBatch;
+    void parkSorting(QTableWidget* t, TableBatch& b);
+    int finishBatch(QTableWidget* t, TableBatch& b);
+    int sortedRow(QTableWidget* t, const TableBatch& b, const QTableWidgetItem* key) const;
+    int findNodeRow(int nodeId) const;
+    int findEdgeRow(const QPair<int,int>& key) const;
+    int nodeDegree(int nodeId) const;
+
     QHash<int, int> m_nodeIdToRow;
     QHash<QPair<int,int>, int> m_edgeKeyToRow;
 
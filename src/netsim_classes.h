@@ -38,6 +38,7 @@
 #include <QOpenGLWidget>
 #include "graphpanel.h"
 #include "datahandler.h"
+#include "frontidmap.h"
 #include "algorithmpanel.h"
 
 QT_BEGIN_NAMESPACE
@@ -79,8 +80,13 @@ public:
     const QVector<int>& memberFrontIds() const { return m_memberFrontIds; }
     qreal contractedRadius() const { return m_contractedRadius; }
 
-    void registerEdge(NetworkEdge* e)   { m_edges.insert(e); }
-    void unregisterEdge(NetworkEdge* e) { m_edges.remove(e); }
+    // incident edge items, kept by the edges themselves as they are created and deleted
+    void registerEdge(NetworkEdge* e);
+    void unregisterEdge(NetworkEdge* e);
+    const QVector<NetworkEdge*>& edges() const { return m_edges; }
+
+    // fill colour picked from a node metric, invalid restores the default fill
+    void setMetricColour(const QColor& colour);
     
     
 protected:
@@ -90,11 +96,12 @@ protected:
 private:
     QString fullLabelText;
 
-    QSet<NetworkEdge*> m_edges;
+    QVector<NetworkEdge*> m_edges;    // each edge remembers its slot here, removal swaps in the last
 
     bool m_contracted = false;
     QVector<int> m_memberFrontIds;
     qreal m_contractedRadius = BASE_RADIUS;
+    QColor m_metricColour;
 };
 
 // an edge connecting two nodes, directed or not
@@ -106,7 +113,7 @@ public:
     NetworkEdge(NetworkNode* source, NetworkNode* destination, bool directed, const QString& label, QGraphicsItem* parent = nullptr, bool labelVisible=true);
     ~NetworkEdge() {
         if (srcNode) srcNode->unregisterEdge(this);
-        if (dstNode) dstNode->unregisterEdge(this);
+        if (dstNode && dstNode != srcNode) dstNode->unregisterEdge(this);
     }
     
     NetworkNode* sourceNode() const { return srcNode; }
@@ -121,6 +128,10 @@ public:
     bool isContractedEdge() const { return m_contractedEdge; }
     int contractedCount() const { return m_contractedCount; }
 
+    // position in an endpoint's incident edge list, a self loop only uses the source slot
+    int slotIn(const NetworkNode* node) const { return node == srcNode ? m_srcSlot : m_dstSlot; }
+    void setSlotIn(const NetworkNode* node, int slot) { (node == srcNode ? m_srcSlot : m_dstSlot) = slot; }
+
     void setLabelVisible(bool visible);
     bool labelVisible = true;
     
@@ -136,6 +147,8 @@ private:
     bool m_contractedEdge = false;
     int m_contractedCount = 1;
     int m_totalNodes = 10;
+    int m_srcSlot = -1;
+    int m_dstSlot = -1;
     QGraphicsTextItem* edgeLabel = nullptr;
     QString fullLabelText;
     QGraphicsRectItem* labelBackground = nullptr;
@@ -162,22 +175,27 @@ public:
 
     GraphPanel* graphPanel = nullptr;
 
-    int registerContractedNode(NetworkNode* contracted, const QVector<int>& memberFrontIds);
+    int registerContractedNode(NetworkNode* contracted, const QVector<int>& childFrontIds);
     void setNodeContractedMapping(int backendNodeId, int nodeFrontId);
     
     const QVector<int> getMembers(int frontId) const{
-        return m_contractedMembers.value(frontId);
+        return m_frontIds.members(frontId).toVector();
     };
 
     void updateSceneRect(int radius = -1);
     void clearLastItems() { lastSelectedItems.clear();}
     void resetView() {onResetView();};
+    qreal viewZoom() const;
     void resetFrontendState();
 
-    int backIdToFrontId(int backId) const { return m_backIdToFrontId.value(backId, backId); }
-    void setBackIdToFrontId(int backId, int frontId) { m_backIdToFrontId[backId] = frontId; }
+    int backIdToFrontId(int backId) const { return m_frontIds.frontOf(backId); }
+    void setBackIdToFrontId(int backId, int frontId) { m_frontIds.setFront(backId, frontId); }
     void AddVisualEdge(int srcFrontId, int dstFrontId, const QString& label, bool directed=false);
 
+    // metric of a visible node, contracted nodes show the largest member value
+    double nodeMetricValue(const QString& metric, int frontId) const;
+    void colourNodesByMetric(const QString& metric);
+
 
 protected:
     bool eventFilter(QObject* watched, QEvent* event) override;
@@ -198,6 +216,8 @@ private slots:
     void onLoadGraph();
     void onViewSettings();
     void onExpandNode(NetworkNode* contractedNode);
+    void onCollapseGroup(int groupId);
+    void updateSemanticZoom();
     void onContractSelected();
     
 
@@ -208,9 +228,8 @@ private:
     
     AlgorithmPanel* algorithmPanel = nullptr;
 
-    QHash<int, int> m_backIdToFrontId;
-    QHash<int, QVector<int>> m_contractedMembers;
-    int m_nextContractedId = -1; 
+    // front id per backend id and the members of each contracted node
+    FrontIdMap m_frontIds;
     
 
     DataHandler* dataHandler = nullptr;
@@ -228,6 +247,21 @@ private:
     bool updatingEdges = false;
 
     QString m_defaultLayoutAlgo = "none";
+
+    // semantic zoom, a pyramid of grid groups in the quotient that expands and collapses with the view
+    bool m_semanticZoom = false;
+    int m_semanticBudget = 2000;        // most node items drawn at once
+    QTimer* m_semanticTimer = nullptr;
+    QVector<QPointF> m_leafPos;         // layout the pyramid was built from
+    QVector<bool> m_leafHasPos;
+    QHash<int, QRectF> m_groupCell;     // grid cell of each pyramid group
+    QHash<int, QPointF> m_groupPos;     // centroid of its members
+
+    void buildSemanticPyramid();
+    void scheduleSemanticZoom();
+    bool expandGroup(int groupId);
+    bool collapseGroup(int groupId);
+    QPointF pyramidPos(int frontId, const QPointF& fallback) const;
     
     void setupConnections();
     void setupViewport();
@@ -245,8 +279,12 @@ private:
     QList<QGraphicsItem*> lastSelectedItems;
 
     
+    // visual edges of a front node built from the quotient arc counts
+    void addQuotientEdges(int frontId);
+    void removeIncidentEdges(int frontId, QSet<QPair<int,int>>* removedKeys = nullptr);
+    void takeEdgeItem(NetworkEdge* edge);
+
     void deleteEdge(NetworkEdge* edge);
-    void deleteNode(NetworkNode* node);
 };
 
 
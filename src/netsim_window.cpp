@@ -51,8 +51,8 @@ void NetworkNode::paint(QPainter *painter, const QStyleOptionGraphicsItem *optio
         const bool selected = option->state & QStyle::State_Selected;
         const qreal r = m_contractedRadius;
 
-        //  light blue fill, default pen (same as normal node)
-        painter->setBrush("#a0cbff"); 
+        //  light blue fill unless coloured by a metric, default pen (same as normal node)
+        painter->setBrush(m_metricColour.isValid() ? QBrush(m_metricColour) : QBrush(QColor("#a0cbff")));
         painter->setPen(pen());
         painter->drawEllipse(QRectF(-r, -r, r * 2, r * 2));
 
@@ -117,6 +117,32 @@ void NetworkNode::setContracted(const QVector<int>& memberFrontIds) {
     update();
 }
 
+// append an incident edge, the edge keeps its slot so removal needs no search
+void NetworkNode::registerEdge(NetworkEdge* e) {
+    e->setSlotIn(this, m_edges.size());
+    m_edges.append(e);
+}
+
+// swap the last edge into the removed slot
+void NetworkNode::unregisterEdge(NetworkEdge* e) {
+    const int slot = e->slotIn(this);
+    if (slot < 0 || slot >= m_edges.size() || m_edges[slot] != e) return;
+
+    NetworkEdge* last = m_edges.takeLast();
+    if (last != e) {
+        m_edges[slot] = last;
+        last->setSlotIn(this, slot);
+    }
+    e->setSlotIn(this, -1);
+}
+
+// fill colour picked from a node metric, invalid restores the default fill
+void NetworkNode::setMetricColour(const QColor& colour) {
+    m_metricColour = colour;
+    setBrush(colour.isValid() ? QBrush(colour) : QBrush(Qt::lightGray));
+    update();
+}
+
 
 
 // ----------------------------------
@@ -134,7 +160,7 @@ NetworkEdge::NetworkEdge(NetworkNode* source, NetworkNode* destination, bool _di
     }
 
     if (srcNode) srcNode->registerEdge(this);
-    if (dstNode) dstNode->registerEdge(this);
+    if (dstNode && dstNode != srcNode) dstNode->registerEdge(this);
 
     // draw edges below nodes
     setZValue(NetworkEdge::DEFAULT_ZVALUE);
@@ -443,6 +469,9 @@ NetSim::NetSim(QWidget *parent)
         ui->statusbar->showMessage("Found selection in graph.");
     });
 
+    // colour nodes by a metric column picked from the node table header
+    connect(graphPanel, &GraphPanel::colourByMetricRequested, this, &NetSim::colourNodesByMetric);
+
     // conect expanding requested
     connect(graphPanel, &GraphPanel::expandRequested, this, [this](int nodeId) {
         NetworkNode* node = nodeItems.value(nodeId);
@@ -477,6 +506,17 @@ NetSim::NetSim(QWidget *parent)
     lay->setContentsMargins(0, 0, 0, 0);
     lay->addWidget(algorithmPanel);
     if (algorithmPanel) algorithmPanel->setData(&nodeItems, &edgeItems, dataHandler);
+
+    // algorithm results are highlighted as a selection, edges are added on top of the nodes
+    connect(algorithmPanel, &AlgorithmPanel::requestHighlightNodes, this, [this](QHash<int, NetworkNode*>& nodes) {
+        scene->clearSelection();
+        for (NetworkNode* node : nodes)
+            node->setSelected(true);
+    });
+    connect(algorithmPanel, &AlgorithmPanel::requestHighlightEdges, this, [this](QHash<QPair<int,int>, NetworkEdge*>& edges) {
+        for (NetworkEdge* edge : edges)
+            edge->setSelected(true);
+    });
     ui->topSplitter->setSizes({800, 500});
 }
 
@@ -561,6 +601,14 @@ void NetSim::setupConnections() {
         QTimer::singleShot(0, this, &NetSim::onSelectionChanged);
     });
 
+    // semantic zoom waits for zooming and panning to settle
+    m_semanticTimer = new QTimer(this);
+    m_semanticTimer->setSingleShot(true);
+    m_semanticTimer->setInterval(120);
+    connect(m_semanticTimer, &QTimer::timeout, this, &NetSim::updateSemanticZoom);
+    connect(ui->graphicsView->horizontalScrollBar(), &QScrollBar::valueChanged, this, &NetSim::scheduleSemanticZoom);
+    connect(ui->graphicsView->verticalScrollBar(), &QScrollBar::valueChanged, this, &NetSim::scheduleSemanticZoom);
+
     connect(ui->panelAddNodeBtn,  &QPushButton::clicked, this, &NetSim::onAddNode);
     connect(ui->panelAddEdgeBtn,  &QPushButton::clicked, this, &NetSim::onAddEdgeBtn);
     connect(ui->panelDeleteBtn,   &QPushButton::clicked, this, &NetSim::onDeleteSelected);
@@ -714,6 +762,15 @@ void NetSim::showContextMenu(const QPoint& viewPos) {
             });
         }
 
+        // nodes shown from an expanded group can fold it back up
+        const int parentGroup = dataHandler->quotient().parentOf(clickedNode->nodeFrontId);
+        if (parentGroup != QuotientGraph::NoGroup) {
+            QAction* collapseAction = menu.addAction("Collapse group");
+            connect(collapseAction, &QAction::triggered, this, [this, parentGroup]() {
+                onCollapseGroup(parentGroup);
+            });
+        }
+
         QAction* deleteAction = menu.addAction("Delete");
         
         // connect delete action
@@ -769,105 +826,467 @@ void NetSim::showContextMenu(const QPoint& viewPos) {
 
 // createItems methods
 
-int NetSim::registerContractedNode(NetworkNode* contracted, const QVector<int>& memberFrontIds)
+int NetSim::registerContractedNode(NetworkNode* contracted, const QVector<int>& childFrontIds)
 {
-    int id = m_nextContractedId--;
+    // the quotient nests the children under a new group, whose id is the front id
+    QuotientGraph& quotient = dataHandler->quotient();
+    const int id = quotient.group(childFrontIds);
+    const QVector<int> members = quotient.leaves(id);
+
     contracted->nodeFrontId = id;
-    contracted->setContracted(memberFrontIds);
-    m_contractedMembers[id] = memberFrontIds;
+    contracted->setContracted(members);
+    m_frontIds.setMembers(id, members);
+
+    // a recycled id may still carry the cell of a pruned pyramid group
+    m_groupCell.remove(id);
+    m_groupPos.remove(id);
     return id;
 }
 
 void NetSim::setNodeContractedMapping(int backendNodeId, int nodeFrontId) {
-    m_backIdToFrontId[backendNodeId] = nodeFrontId;
+    m_frontIds.setFront(backendNodeId, nodeFrontId);
 }
 
-// expand a contracted node
-void NetSim::onExpandNode(NetworkNode* contractedNode) {
-    if (!contractedNode || !contractedNode->isContracted()) return;
+// draw the edges from a front node to its quotient neighbours, pairs already drawn are skipped
+void NetSim::addQuotientEdges(int frontId)
+{
+    const QuotientGraph& quotient = dataHandler->quotient();
+    const int totalNodes = nodeItems.size();
 
-    int contractedId = contractedNode->nodeFrontId;
-    QVector<int> memberBackIds = m_contractedMembers.value(contractedId);
-    if (memberBackIds.isEmpty()) return;
+    auto draw = [&](int src, int dst, int count) {
+        if (!nodeItems.contains(src) || !nodeItems.contains(dst)) return;
+        const QPair<int,int> key = directedEdges
+            ? qMakePair(src, dst)
+            : qMakePair(qMin(src, dst), qMax(src, dst));
+        if (edgeItems.contains(key)) return;
+
+        // a single backend edge keeps its own label
+        const bool contracted = src < 0 || dst < 0 || count > 1;
+        QString label = QString("x%1").arg(count);
+        if (!contracted) {
+            for (const EdgeInfo& e : dataHandler->getEdgesOf(src))
+                if (e.destination == dst) { label = e.label; break; }
+        }
+
+        AddVisualEdge(src, dst, label, directedEdges);
+        NetworkEdge* edge = edgeItems.value(key);
+        if (edge && contracted) {
+            edge->setContracted(true, count, totalNodes);
+            if (graphPanel) graphPanel->updateEdgeRow(src, dst);
+        }
+    };
+
+    const QHash<int,int> out = quotient.outArcs(frontId);
+    for (auto it = out.cbegin(); it != out.cend(); ++it)
+        draw(frontId, it.key(), it.value());
 
-    for (int backId : memberBackIds) {
-        m_backIdToFrontId[backId] = backId;
+    if (directedEdges) {
+        const QHash<int,int> in = quotient.inArcs(frontId);
+        for (auto it = in.cbegin(); it != in.cend(); ++it)
+            draw(it.key(), frontId, it.value());
     }
+}
 
-    QSet<NetworkEdge*> edgesToDelete;
+// drop an edge item from edgeItems under both key orders, its endpoints give the keys
+void NetSim::takeEdgeItem(NetworkEdge* edge)
+{
+    const int src = edge->sourceNode()->nodeFrontId;
+    const int dst = edge->destNode()->nodeFrontId;
+    if (edgeItems.value(qMakePair(src, dst)) == edge) edgeItems.remove(qMakePair(src, dst));
+    if (edgeItems.value(qMakePair(dst, src)) == edge) edgeItems.remove(qMakePair(dst, src));
+}
 
-    // delete edge connected to the contracted node
-    for (auto it = edgeItems.begin(); it != edgeItems.end(); ) {
-        int fSrc = it.key().first;
-        int fDst = it.key().second;
+// delete the visual edges of a front node through its incidence list, no edgeItems scan
+void NetSim::removeIncidentEdges(int frontId, QSet<QPair<int,int>>* removedKeys)
+{
+    NetworkNode* node = nodeItems.value(frontId);
+    if (!node) return;
 
-        if (fSrc == contractedId || fDst == contractedId) {
-            edgesToDelete.insert(it.value());
-            it = edgeItems.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // deleting an edge unregisters it from the list, so work on a copy
+    const QVector<NetworkEdge*> incident = node->edges();
+    for (NetworkEdge* edge : incident) {
+        const int src = edge->sourceNode()->nodeFrontId;
+        const int dst = edge->destNode()->nodeFrontId;
+        if (removedKeys) removedKeys->insert({qMin(src, dst), qMax(src, dst)});
 
-    for (NetworkEdge* edge : edgesToDelete) {
+        takeEdgeItem(edge);
+        lastSelectedItems.removeOne(edge);
         scene->removeItem(edge);
         delete edge;
     }
+}
+
+// layout position of a front node when the semantic zoom pyramid knows it
+QPointF NetSim::pyramidPos(int frontId, const QPointF& fallback) const
+{
+    if (frontId < 0) return m_groupPos.value(frontId, fallback);
+    if (frontId < m_leafHasPos.size() && m_leafHasPos[frontId]) return m_leafPos[frontId];
+    return fallback;
+}
+
+// swap a drawn group for its children, nested groups stay contracted. only the
+// group, its children and their edges are touched, rows included. callers wrap
+// this in a graph panel batch
+bool NetSim::expandGroup(int groupId)
+{
+    QuotientGraph& quotient = dataHandler->quotient();
+    NetworkNode* contractedNode = nodeItems.value(groupId);
+    if (!contractedNode || !quotient.isFront(groupId)) return false;
+
+    QSet<QPair<int,int>> removedKeys;
+    removeIncidentEdges(groupId, &removedKeys);
+    quotient.expand(groupId);
+    const QVector<int> children = quotient.children(groupId);
 
-    scene->blockSignals(true);
-    
     // Remove the contracted node from front‑end
-    nodeItems.remove(contractedId);
+    lastSelectedItems.removeOne(contractedNode);
+    nodeItems.remove(groupId);
     scene->removeItem(contractedNode);
+    m_frontIds.removeMembers(groupId);
 
-    // Recreate all member nodes using backend data
-    QHash<int, NetworkNode*> newNodes;
-    QPointF center = contractedNode->pos();
-    int count = memberBackIds.size();
+    // children go back to their layout position, or a small circle around the group
+    const QPointF center = contractedNode->pos();
+    const int count = children.size();
+    const qreal radius = 40.0 + count * 2.0;
     for (int i = 0; i < count; ++i) {
-        int nodeId = memberBackIds[i];
-        const NodeInfo* info = dataHandler->getNode(nodeId);
-        if (!info) continue;
+        const int child = children[i];
+        const qreal angle = 2.0 * M_PI * i / count;
+        const QPointF pos = pyramidPos(child, center + QPointF(radius * cos(angle), radius * sin(angle)));
+
+        NetworkNode* node = nullptr;
+        if (child < 0) {
+            const QVector<int> members = quotient.leaves(child);
+            node = new NetworkNode(pos.x(), pos.y(), QString("x%1").arg(members.size()));
+            node->nodeFrontId = child;
+            node->setContracted(members);
+            m_frontIds.setMembers(child, members);
+            for (int backId : members)
+                m_frontIds.setFront(backId, child);
+        } else {
+            node = new NetworkNode(pos.x(), pos.y(), dataHandler->nodeLabel(child));
+            node->nodeFrontId = child;
+            m_frontIds.setFront(child, child);
+        }
+        scene->addItem(node);
+        nodeItems[child] = node;
+    }
 
-        // Place nodes in a small circle around the contracted node's position
-        qreal angle = 2.0 * M_PI * i / count;
-        qreal radius = 40.0 + count * 2.0; 
-        QPointF pos = center + QPointF(radius * cos(angle), radius * sin(angle));
+    // child rows go in before the edges so the edge rows can update their degrees
+    if (graphPanel) {
+        for (const QPair<int,int>& key : removedKeys)
+            graphPanel->removeEdgeRow(key.first, key.second);
+        graphPanel->removeNodeRow(groupId);
+        for (int child : children)
+            graphPanel->addNodeRow(child);
+    }
 
-        NetworkNode* node = new NetworkNode(pos.x(), pos.y(), dataHandler->nodeLabel(nodeId));
-        node->nodeFrontId = nodeId;
-        scene->addItem(node);
+    for (int child : children)
+        addQuotientEdges(child);
 
-        if (nodeItems.contains(nodeId)) {
-            delete nodeItems[nodeId];
-        }
-        nodeItems[nodeId] = node;
-        newNodes[nodeId] = node;
+    delete contractedNode;
+    return true;
+}
+
+// fold everything drawn below a group back into one contracted node
+bool NetSim::collapseGroup(int groupId)
+{
+    QuotientGraph& quotient = dataHandler->quotient();
+    if (!quotient.isGroup(groupId) || quotient.isFront(groupId)) return false;
+
+    // only groups whose descendants are on screen can fold
+    const QVector<int> members = quotient.leaves(groupId);
+    if (members.isEmpty() || quotient.depth(quotient.frontOf(members.first())) <= quotient.depth(groupId))
+        return false;
+
+    QSet<int> drawn;
+    for (int backId : members)
+        drawn.insert(quotient.frontOf(backId));
+
+    // take the drawn descendants and their edges off the scene
+    QSet<QPair<int,int>> removedKeys;
+    QPointF centroid(0, 0);
+    int placed = 0;
+    for (int frontId : drawn) {
+        removeIncidentEdges(frontId, &removedKeys);
+        NetworkNode* node = nodeItems.take(frontId);
+        m_frontIds.removeMembers(frontId);
+        if (!node) continue;
+        centroid += node->pos();
+        ++placed;
+        lastSelectedItems.removeOne(node);
+        scene->removeItem(node);
+        delete node;
     }
+    if (placed > 0) centroid /= placed;
 
-    // Restore edges among member nodes
-    for (int src : memberBackIds) {
-        const QVector<EdgeInfo> edges = dataHandler->getEdgesOf(src);
-        for (const EdgeInfo& e : edges) {
-            int dst = e.destination;
+    quotient.collapse(groupId);
 
-            int fSrc = backIdToFrontId(src);
-            int fDst = backIdToFrontId(dst);
+    const QPointF pos = pyramidPos(groupId, centroid);
+    NetworkNode* contracted = new NetworkNode(pos.x(), pos.y(), QString("x%1").arg(members.size()));
+    contracted->nodeFrontId = groupId;
+    contracted->setContracted(members);
+    m_frontIds.setMembers(groupId, members);
+    for (int backId : members)
+        m_frontIds.setFront(backId, groupId);
+    scene->addItem(contracted);
+    nodeItems[groupId] = contracted;
 
-            AddVisualEdge(fSrc, fDst, e.label, directedEdges);
-        }
+    if (graphPanel) {
+        for (const QPair<int,int>& key : removedKeys)
+            graphPanel->removeEdgeRow(key.first, key.second);
+        for (int frontId : drawn)
+            graphPanel->removeNodeRow(frontId);
+        graphPanel->addNodeRow(groupId);
     }
+
+    addQuotientEdges(groupId);
+    return true;
+}
+
+// expand a contracted node into its children
+void NetSim::onExpandNode(NetworkNode* contractedNode) {
+    if (!contractedNode || !contractedNode->isContracted()) return;
+
+    const int contractedId = contractedNode->nodeFrontId;
+    const int memberCount = dataHandler->quotient().leafCount(contractedId);
+
+    scene->blockSignals(true);
+    if (graphPanel) graphPanel->beginBatch();
+    const bool expanded = expandGroup(contractedId);
+    if (graphPanel) graphPanel->endBatch();
     scene->blockSignals(false);
+    if (!expanded) return;
 
-    // Clean up mapping
-    m_contractedMembers.remove(contractedId);
+    updateSceneRect();
+    ui->statusbar->showMessage(QString("Expanded group with %1 nodes into %2")
+                                   .arg(memberCount)
+                                   .arg(dataHandler->quotient().children(contractedId).size()));
+}
 
-    delete contractedNode;
+void NetSim::onCollapseGroup(int groupId) {
+    scene->blockSignals(true);
+    if (graphPanel) graphPanel->beginBatch();
+    const bool collapsed = collapseGroup(groupId);
+    if (graphPanel) graphPanel->endBatch();
+    scene->blockSignals(false);
+    if (!collapsed) return;
 
-    // Update panels and scene
+    updateSceneRect();
+    ui->statusbar->showMessage(QString("Collapsed %1 nodes into one").arg(dataHandler->quotient().leafCount(groupId)));
+}
+
+// ------------------------------
+// semantic zoom
+// ------------------------------
+
+// rebuild the scene as nested grid groups over the current layout. cells double in
+// size from the finest level that still merges nodes up to a top level of at most
+// half the node budget, so a zoomed out view starts with few super-nodes
+void NetSim::buildSemanticPyramid()
+{
+    QVector<bool> hasPos;
+    const QVector<QPointF> pos = algorithmPanel->backendPositions(hasPos);
+
+    qreal minX = 0, maxX = 0, minY = 0, maxY = 0;
+    int placed = 0;
+    for (int v = 0; v < pos.size(); ++v) {
+        if (hasPos[v] && !dataHandler->nodeExists(v)) hasPos[v] = false;
+        if (!hasPos[v]) continue;
+        const QPointF p = pos[v];
+        if (placed++ == 0) { minX = maxX = p.x(); minY = maxY = p.y(); }
+        minX = qMin(minX, p.x()); maxX = qMax(maxX, p.x());
+        minY = qMin(minY, p.y()); maxY = qMax(maxY, p.y());
+    }
+    if (placed < 2) return;
+
+    // coarsest cell first, then halve while a level still merges a fair share of nodes
+    double top = qMax(1.0, qMax(maxX - minX, maxY - minY) / 16.0);
+    while (gridCells(pos, hasPos, top).count() > qMax(1, m_semanticBudget / 2)) top *= 2.0;
+
+    QVector<double> cellSizes = { top };
+    for (double cell = top / 2.0; cell >= 1.0 && cellSizes.size() < 16; cell /= 2.0) {
+        if (gridCells(pos, hasPos, cell).count() > placed * 0.7) break;
+        cellSizes.prepend(cell);
+    }
+
+    // full teardown, the pyramid replaces any earlier contraction
+    scene->clearSelection();
+    lastSelectedItems.clear();
+    scene->blockSignals(true);
+
+    QSet<NetworkEdge*> uniqueEdges(edgeItems.begin(), edgeItems.end());
+    for (NetworkEdge* e : uniqueEdges) { scene->removeItem(e); delete e; }
+    edgeItems.clear();
+    for (NetworkNode* node : nodeItems) { scene->removeItem(node); delete node; }
+    nodeItems.clear();
+    resetFrontendState();
+
+    m_leafPos = pos;
+    m_leafHasPos = hasPos;
+
+    // group bottom up, each level buckets the groups of the level below by their centroid
+    QuotientGraph& quotient = dataHandler->quotient();
+    QVector<int> front;
+    QVector<QPointF> frontPos;
+    QVector<int> weight;
+    for (int v = 0; v < pos.size(); ++v) {
+        if (!hasPos[v]) continue;
+        front.append(v);
+        frontPos.append(pos[v]);
+        weight.append(1);
+    }
+
+    for (double cell : cellSizes) {
+        const GridCells grid = gridCells(frontPos, QVector<bool>(), cell);
+        QVector<QVector<int>> cellMembers(grid.count());
+        for (int i = 0; i < front.size(); ++i)
+            cellMembers[grid.cellOf[i]].append(i);
+
+        QVector<int> nextFront;
+        QVector<QPointF> nextPos;
+        QVector<int> nextWeight;
+        for (int c = 0; c < grid.count(); ++c) {
+            const QVector<int>& idx = cellMembers[c];
+            if (idx.size() == 1) {
+                nextFront.append(front[idx[0]]);
+                nextPos.append(frontPos[idx[0]]);
+                nextWeight.append(weight[idx[0]]);
+                continue;
+            }
+
+            QVector<int> ids;
+            QPointF centroid(0, 0);
+            int total = 0;
+            for (int i : idx) {
+                ids.append(front[i]);
+                centroid += frontPos[i] * weight[i];
+                total += weight[i];
+            }
+            centroid /= total;
+
+            const int g = quotient.group(ids);
+            m_groupPos[g] = centroid;
+            m_groupCell[g] = QRectF(grid.coords[c].x() * cell, grid.coords[c].y() * cell, cell, cell);
+            nextFront.append(g);
+            nextPos.append(centroid);
+            nextWeight.append(total);
+        }
+        front = nextFront;
+        frontPos = nextPos;
+        weight = nextWeight;
+    }
+
+    // draw the top level
+    for (int i = 0; i < front.size(); ++i) {
+        const int id = front[i];
+        NetworkNode* node = nullptr;
+        if (id < 0) {
+            const QVector<int> members = quotient.leaves(id);
+            node = new NetworkNode(frontPos[i].x(), frontPos[i].y(), QString("x%1").arg(members.size()));
+            node->nodeFrontId = id;
+            node->setContracted(members);
+            m_frontIds.setMembers(id, members);
+            for (int backId : members)
+                m_frontIds.setFront(backId, id);
+        } else {
+            node = new NetworkNode(frontPos[i].x(), frontPos[i].y(), dataHandler->nodeLabel(id));
+            node->nodeFrontId = id;
+        }
+        scene->addItem(node);
+        nodeItems[id] = node;
+    }
+    for (int id : front)
+        addQuotientEdges(id);
+
+    scene->blockSignals(false);
     updateSceneRect();
     if (graphPanel) graphPanel->refresh();
-    ui->statusbar->showMessage(QString("Expanded component with %1 nodes").arg(memberBackIds.size()));
+    ui->statusbar->showMessage(QString("Semantic zoom: %1 levels, %2 super-nodes at the top")
+                                   .arg(cellSizes.size()).arg(front.size()));
+}
+
+// wait for the view to settle before expanding or collapsing
+void NetSim::scheduleSemanticZoom()
+{
+    if (m_semanticZoom && m_semanticTimer) m_semanticTimer->start();
+}
+
+// pick the pyramid level per region from the zoom. a group is expanded once its cell
+// spans twice the grid cell size on screen and it overlaps the view, and folded
+// again below one cell size or once it leaves the view. expansions stop at the budget
+void NetSim::updateSemanticZoom()
+{
+    if (!m_semanticZoom || m_groupCell.isEmpty()) return;
+
+    QuotientGraph& quotient = dataHandler->quotient();
+    const qreal zoom = viewZoom();
+    const double cellPixels = algorithmPanel->m_gridContractParams.cellPixels;
+    const QRectF visible = ui->graphicsView->mapToScene(ui->graphicsView->viewport()->rect()).boundingRect();
+
+    // most debounced pans change nothing, the batch only opens before the first edit
+    bool batchOpen = false;
+    auto openBatch = [&]() {
+        if (batchOpen) return;
+        batchOpen = true;
+        scene->blockSignals(true);
+        if (graphPanel) graphPanel->beginBatch();
+    };
+    int expanded = 0, collapsed = 0;
+
+    // fold first to free budget, deepest groups before their ancestors
+    for (;;) {
+        QSet<int> parents;
+        for (auto it = nodeItems.cbegin(); it != nodeItems.cend(); ++it) {
+            const int p = quotient.parentOf(it.key());
+            if (p != QuotientGraph::NoGroup && m_groupCell.contains(p)) parents.insert(p);
+        }
+
+        QVector<int> fold;
+        for (int p : parents) {
+            const QRectF cell = m_groupCell.value(p);
+            if (cell.width() * zoom < cellPixels || !cell.intersects(visible)) fold.append(p);
+        }
+        if (fold.isEmpty()) break;
+
+        std::sort(fold.begin(), fold.end(), [&](int a, int b) { return quotient.depth(a) > quotient.depth(b); });
+        openBatch();
+        int folded = 0;
+        for (int p : fold)
+            if (collapseGroup(p)) ++folded;
+        if (folded == 0) break;
+        collapsed += folded;
+    }
+
+    // then open the largest visible groups first while the budget allows
+    for (;;) {
+        QVector<int> open;
+        for (auto it = nodeItems.cbegin(); it != nodeItems.cend(); ++it) {
+            const int id = it.key();
+            if (id >= 0 || !m_groupCell.contains(id)) continue;
+            const QRectF cell = m_groupCell.value(id);
+            if (cell.width() * zoom >= 2.0 * cellPixels && cell.intersects(visible)) open.append(id);
+        }
+        if (open.isEmpty()) break;
+
+        std::sort(open.begin(), open.end(), [&](int a, int b) { return quotient.leafCount(a) > quotient.leafCount(b); });
+        int opened = 0;
+        for (int g : open) {
+            if (nodeItems.size() + quotient.children(g).size() - 1 > m_semanticBudget) continue;
+            openBatch();
+            if (expandGroup(g)) ++opened;
+        }
+        if (opened == 0) break;
+        expanded += opened;
+    }
+
+    if (batchOpen) {
+        if (graphPanel) graphPanel->endBatch();
+        scene->blockSignals(false);
+    }
+    if (expanded == 0 && collapsed == 0) return;
+
+    ui->statusbar->showMessage(QString("Semantic zoom: %1 expanded, %2 collapsed, %3 nodes drawn")
+                                   .arg(expanded).arg(collapsed).arg(nodeItems.size()));
 }
 
 // ------------------------------
@@ -1048,8 +1467,7 @@ void NetSim::onContractSelected() {
         frontIdsBeingRemoved.insert(frontId);
 
         if (node->isContracted()) {
-            const QVector<int>& members = m_contractedMembers.value(frontId);
-            for (int id : members)
+            for (int id : m_frontIds.members(frontId))
                 finalMembers.insert(id);
 
             frontIdsToRemove.append(frontId);
@@ -1069,117 +1487,41 @@ void NetSim::onContractSelected() {
 
     scene->blockSignals(true);
 
-    // Create the new contracted node
+    // take the edges of the selected nodes off the scene
+    QSet<QPair<int,int>> removedEdgeKeys;
+    for (int frontId : frontIdsBeingRemoved)
+        removeIncidentEdges(frontId, &removedEdgeKeys);
+
+    // Create the new contracted node, nested in the quotient over the selected nodes
     NetworkNode* contracted = new NetworkNode(
         centroid.x(), centroid.y(),
         QString("Contracted (%1)").arg(allBackIds.size())
     );
-    int newFrontId = registerContractedNode(contracted, allBackIds);
-    contracted->nodeFrontId = newFrontId;
+    const QVector<int> childFrontIds(frontIdsBeingRemoved.begin(), frontIdsBeingRemoved.end());
+    int newFrontId = registerContractedNode(contracted, childFrontIds);
     scene->addItem(contracted);
     nodeItems[newFrontId] = contracted;
 
     // Update front mapping for all involved backend nodes
     for (int backId : allBackIds) {
-        m_backIdToFrontId[backId] = newFrontId;
+        m_frontIds.setFront(backId, newFrontId);
     }
 
     // Remove old contracted mappings
     for (int oldFrontId : frontIdsToRemove) {
-        m_contractedMembers.remove(oldFrontId);
-    }
-
-    // get edges to be removed
-    QSet<QPair<int,int>> removedEdgeKeys;
-    for (auto it = edgeItems.begin(); it != edgeItems.end(); ++it) {
-        int u = it.key().first;
-        int v = it.key().second;
-
-        if (frontIdsBeingRemoved.contains(u) || frontIdsBeingRemoved.contains(v)) {
-            removedEdgeKeys.insert({qMin(u, v), qMax(u, v)});
-        }
-    }
-
-    // Collect edges to delete
-    QSet<NetworkEdge*> edgesToDelete;
-    for (auto it = edgeItems.begin(); it != edgeItems.end(); ++it) {
-        const QPair<int,int>& key = it.key();
-        if (frontIdsBeingRemoved.contains(key.first) || frontIdsBeingRemoved.contains(key.second)) {
-            edgesToDelete.insert(it.value());
-        }
-    }
-
-    // Remove from map
-    for (auto it = edgeItems.begin(); it != edgeItems.end(); ) {
-        if (edgesToDelete.contains(it.value())) {
-            it = edgeItems.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
-    // Delete edges
-    for (NetworkEdge* edge : edgesToDelete) {
-        scene->removeItem(edge);
-        delete edge;
+        m_frontIds.removeMembers(oldFrontId);
     }
 
-    
     // Remove the original selected nodes
     for (NetworkNode* node : selectedNodes) {
         nodeItems.remove(node->nodeFrontId);
+        lastSelectedItems.removeOne(node);
         scene->removeItem(node);
         delete node;
     }
 
-    // Build external connections
-    QHash<int, int>     externalConnectors;   // otherFrontId → total edge count
-    QHash<int, QString> externalEdgeLabel;
-    QSet<QPair<int,int>> visitedBack;
-
-    for (int backId : allBackIds) {
-        for (const EdgeInfo& e : dataHandler->getEdgesOf(backId)) {
-            int otherBackId = e.destination;
-            if (finalMembers.contains(otherBackId)) continue;
-
-            QPair<int,int> backKey = directedEdges
-                ? qMakePair(backId, otherBackId)
-                : qMakePair(qMin(backId, otherBackId), qMax(backId, otherBackId));
-            if (visitedBack.contains(backKey)) continue;
-            visitedBack.insert(backKey);
-
-            int otherFrontId = m_backIdToFrontId.value(otherBackId, otherBackId);
-            externalConnectors[otherFrontId]++;
-            if (!externalEdgeLabel.contains(otherFrontId))
-                externalEdgeLabel[otherFrontId] = e.label;
-        }
-    }
-
-    const int totalNodes = nodeItems.size();
-    for (auto it = externalConnectors.cbegin(); it != externalConnectors.cend(); ++it) {
-        int externalFrontId = it.key();
-        int count           = it.value();
-        NetworkNode* externalNode = nodeItems.value(externalFrontId);
-        if (!externalNode) continue;
-
-        NetworkEdge* mergedEdge = new NetworkEdge(
-            contracted, externalNode, directedEdges,
-            QString("x%1").arg(count), nullptr, showEdgeLabels);
-        mergedEdge->setContracted(true, count, totalNodes);
-        scene->addItem(mergedEdge);
-        edgeItems[qMakePair(newFrontId, externalFrontId)] = mergedEdge;
-        if (!directedEdges)
-            edgeItems[qMakePair(externalFrontId, newFrontId)] = mergedEdge;
-    }
-
-    // Update scene
-    scene->blockSignals(false);
-    scene->update();
-    updateSceneRect();
-
-    // Update graph panel
+    // Update graph panel rows before the new edges add theirs
     if (graphPanel) {
-        // Remove nodes
         for (int frontId : frontIdsBeingRemoved) {
             graphPanel->removeNodeRow(frontId);
         }
@@ -1187,15 +1529,17 @@ void NetSim::onContractSelected() {
         for (const QPair<int,int>& key : removedEdgeKeys)
             graphPanel->removeEdgeRow(key.first, key.second);
 
-        // Add new node + edges
         graphPanel->addNodeRow(newFrontId);
-        for (auto it = externalConnectors.begin(); it != externalConnectors.end(); ++it) {
-            int externalFrontId = it.key();
-            if (!nodeItems.contains(externalFrontId)) continue;
-            graphPanel->addEdgeRow(newFrontId, externalFrontId);
-        }
     }
 
+    // one edge per neighbour, weighted by the arcs the quotient counted
+    addQuotientEdges(newFrontId);
+
+    // Update scene
+    scene->blockSignals(false);
+    scene->update();
+    updateSceneRect();
+
     ui->statusbar->showMessage(
         QString("Contracted %1 nodes into one").arg(allBackIds.size())
     );
@@ -1235,18 +1579,26 @@ void NetSim::clearGraph() {
 
     if (graphPanel) graphPanel->clear();
 
-    m_backIdToFrontId.clear();
-    m_contractedMembers.clear();
-    m_nextContractedId = -1;
+    m_frontIds.clear();
+    m_groupCell.clear();
+    m_groupPos.clear();
+    m_leafPos.clear();
+    m_leafHasPos.clear();
+    m_semanticZoom = false;
 
     updateSceneRect();
 }
 
-// clear just the front end items
+// clear just the front end items. the pyramid goes with them, so semantic zoom is off
+// until it is turned on again in the settings
 void NetSim::resetFrontendState() {
-    m_backIdToFrontId.clear();
-    m_contractedMembers.clear();
-    m_nextContractedId = -1;
+    m_frontIds.clear();
+    m_groupCell.clear();
+    m_groupPos.clear();
+    m_leafPos.clear();
+    m_leafHasPos.clear();
+    m_semanticZoom = false;
+    dataHandler->quotient().flatten();
 }
 
 // add node action
@@ -1525,6 +1877,49 @@ void NetSim::AddVisualEdge(int srcId, int dstId, const QString& label, bool dire
 }
 
 
+// metric value of a visible node, contracted nodes take their largest member value
+double NetSim::nodeMetricValue(const QString& metric, int frontId) const {
+    if (frontId >= 0) return dataHandler->nodeMetric(metric, frontId);
+
+    double best = NAN;
+    for (int member : m_frontIds.members(frontId)) {
+        const double value = dataHandler->nodeMetric(metric, member);
+        if (!std::isnan(value) && (std::isnan(best) || value > best)) best = value;
+    }
+    return best;
+}
+
+// colour every node on a grey to red scale by a metric, empty name resets the colours
+void NetSim::colourNodesByMetric(const QString& metric) {
+    // range over the visible nodes
+    double lo = NAN, hi = NAN;
+    if (!metric.isEmpty()) {
+        for (auto it = nodeItems.cbegin(); it != nodeItems.cend(); ++it) {
+            const double value = nodeMetricValue(metric, it.key());
+            if (std::isnan(value)) continue;
+            if (std::isnan(lo) || value < lo) lo = value;
+            if (std::isnan(hi) || value > hi) hi = value;
+        }
+    }
+
+    const QColor low(225, 230, 240), high(210, 50, 40);
+    for (auto it = nodeItems.cbegin(); it != nodeItems.cend(); ++it) {
+        const double value = metric.isEmpty() ? NAN : nodeMetricValue(metric, it.key());
+        if (std::isnan(value)) {
+            it.value()->setMetricColour(QColor());
+            continue;
+        }
+        const double t = hi > lo ? (value - lo) / (hi - lo) : 1.0;
+        it.value()->setMetricColour(QColor::fromRgbF(low.redF()   + t * (high.redF()   - low.redF()),
+                                                     low.greenF() + t * (high.greenF() - low.greenF()),
+                                                     low.blueF()  + t * (high.blueF()  - low.blueF())));
+    }
+
+    if (metric.isEmpty()) ui->statusbar->showMessage("Cleared node colouring.");
+    else ui->statusbar->showMessage(QString("Nodes coloured by %1 (%2 to %3).")
+                                    .arg(metric).arg(lo, 0, 'g', 4).arg(hi, 0, 'g', 4));
+}
+
 // delete an edge from the scene and both nodes
 void NetSim::deleteEdge(NetworkEdge* edge) {
     if (!edge) return;
@@ -1546,14 +1941,14 @@ void NetSim::deleteEdge(NetworkEdge* edge) {
         if (externalFrontId >= 0) {
             externalBackIds.insert(externalFrontId);
         } else {
-            for (int id : m_contractedMembers.value(externalFrontId))
+            for (int id : m_frontIds.members(externalFrontId))
                 externalBackIds.insert(id);
         }
 
         // Delete every backend edge from a contracted member to the external side
-        for (int backId : m_contractedMembers.value(contractedFrontId)) {
+        for (int backId : m_frontIds.members(contractedFrontId)) {
             for (const EdgeInfo& e : dataHandler->getEdgesOf(backId)) {
-                int destFrontId = m_backIdToFrontId.value(e.destination, e.destination);
+                int destFrontId = m_frontIds.frontOf(e.destination);
                 if (destFrontId == externalFrontId || externalBackIds.contains(e.destination)) {
                     dataHandler->removeEdge(backId, e.destination);
                     if (!directedEdges)
@@ -1570,10 +1965,7 @@ void NetSim::deleteEdge(NetworkEdge* edge) {
     }
 
     // Remove from map
-    edgeItems.remove(QPair<int,int>(srcFrontId, dstFrontId));
-    if (!directedEdges) {
-        edgeItems.remove(QPair<int,int>(dstFrontId, srcFrontId));
-    }
+    takeEdgeItem(edge);
 
     lastSelectedItems.removeOne(edge);
 
@@ -1581,96 +1973,6 @@ void NetSim::deleteEdge(NetworkEdge* edge) {
     delete edge;
 }
 
-// delete node from the scene and all connected edges
-void NetSim::deleteNode(NetworkNode* node) {
-    if (!node) return;
-    int nodeFrontId = node->nodeFrontId;
-
-    lastSelectedItems.removeOne(node);
-
-    // if node is contracted
-    if (node->isContracted()) {
-        QVector<int> memberBackIds = m_contractedMembers.value(nodeFrontId);
-
-        // Delete all backend edges incident to each member
-        for (int backId : memberBackIds) {
-            const QVector<EdgeInfo> incident = dataHandler->getEdgesOf(backId);
-            for (const EdgeInfo& e : incident) {
-                dataHandler->removeEdge(backId, e.destination);
-                if (!directedEdges)
-                    dataHandler->removeEdge(e.destination, backId);
-            }
-        }
-
-        // Delete all member nodes from backend
-        for (int backId : memberBackIds) {
-            dataHandler->removeNodeNoEdges(backId);
-            m_backIdToFrontId.remove(backId);
-            if (graphPanel)
-                graphPanel->removeNodeRow(backId);
-        }
-
-        QSet<NetworkEdge*> edgesToDelete;
-        QSet<QPair<int,int>> normKeysForPanel;
-
-        // get edges to delete
-        for (auto it = edgeItems.begin(); it != edgeItems.end(); ) {
-            QPair<int,int> key = it.key();
-            if (key.first == nodeFrontId || key.second == nodeFrontId) {
-                edgesToDelete.insert(it.value());
-                normKeysForPanel.insert({qMin(key.first, key.second), qMax(key.first, key.second)});
-                it = edgeItems.erase(it);
-            } else {
-                ++it;
-            }
-        }
-
-        // Remove panel rows before deleting pointers
-        if (graphPanel) {
-            for (const QPair<int,int>& key : normKeysForPanel)
-                graphPanel->removeEdgeRow(key.first, key.second);
-        }
-
-        // delete edge items
-        for (NetworkEdge* edge : edgesToDelete) {
-            scene->removeItem(edge);
-            delete edge;
-        }
-
-        // delete node item
-        m_contractedMembers.remove(nodeFrontId);
-        nodeItems.remove(nodeFrontId);
-        scene->removeItem(node);
-        delete node;
-
-        if (graphPanel) graphPanel->removeNodeRow(nodeFrontId);
-        return;
-    }
-
-    // Get all edges incident to this node from backend
-    const QVector<EdgeInfo> incidentEdges = dataHandler->getEdgesOf(nodeFrontId);
-    for (const EdgeInfo& e : incidentEdges) {
-        int neighborFrontId = e.destination;
-
-        // Look up the visual edge
-        NetworkEdge* edge = edgeItems.value(QPair<int,int>(nodeFrontId, neighborFrontId));
-        if (!edge && !directedEdges) {
-            edge = edgeItems.value(QPair<int,int>(neighborFrontId, nodeFrontId));
-        }
-        if (edge) {
-            deleteEdge(edge);
-        }
-    }
-
-    // removes a node with no edges so we dont have to loop through edges
-    dataHandler->removeNodeNoEdges(nodeFrontId);
-
-    // remove item node
-    nodeItems.remove(nodeFrontId);
-    scene->removeItem(node);
-    delete node;
-}
-
 // delete all selected items
 void NetSim::onDeleteSelected() {
     QList<QGraphicsItem*> selectedItems = scene->selectedItems();
@@ -1692,48 +1994,80 @@ void NetSim::onDeleteSelected() {
             selectedEdges.append(edge);
     }
 
-    // collect edge keys before any deletion so we don't dereference deleted pointers
-    QList<QPair<int,int>> edgeKeysToDelete;
-    for (NetworkEdge* edge : selectedEdges) {
-        QPair<int,int> key = {qMin(edge->sourceNode()->nodeFrontId, edge->destNode()->nodeFrontId),
-                              qMax(edge->sourceNode()->nodeFrontId, edge->destNode()->nodeFrontId)};
-        edgeKeysToDelete.append(key);
+    // mark everything first: the selected front nodes, their backend ids and every edge
+    // item touching them. nothing is deleted until the whole selection is known
+    QSet<int> deletedFronts;
+    QVector<int> deletedBackIds;
+    for (NetworkNode* node : selectedNodes) {
+        const int frontId = node->nodeFrontId;
+        deletedFronts.insert(frontId);
+        if (node->isContracted()) {
+            for (int backId : m_frontIds.members(frontId))
+                deletedBackIds.append(backId);
+        } else {
+            deletedBackIds.append(frontId);
+        }
     }
 
-    // First delete nodes and their incident edges
-    for (NetworkNode* node : selectedNodes) {
-        int nodeFrontId = node->nodeFrontId;
+    QSet<NetworkEdge*> incidentEdges;
+    for (NetworkNode* node : selectedNodes)
+        for (NetworkEdge* edge : node->edges())
+            incidentEdges.insert(edge);
 
-        // capture incident edge keys BEFORE deleteNode removes them
-        const QVector<EdgeInfo> incident = dataHandler->getEdgesOf(nodeFrontId);
-        QList<QPair<int,int>> incidentKeys;
-        for (const EdgeInfo& e : incident)
-            incidentKeys.append({qMin(nodeFrontId, e.destination), qMax(nodeFrontId, e.destination)});
+    scene->blockSignals(true);
+    if (graphPanel) graphPanel->beginBatch();
 
-        deleteNode(node);
+    // nothing selected survives, so the list is dropped in one go instead of per item
+    lastSelectedItems.clear();
 
-        // remove node row and all incident edge rows from the panel
-        if (graphPanel) {
-            graphPanel->removeNodeRow(nodeFrontId);
-            for (const QPair<int,int>& key : incidentKeys)
-                graphPanel->removeEdgeRow(key.first, key.second);
-        }
+    // selected edges between surviving nodes still go through the backend one by one
+    QSet<int> touchedFronts;
+    for (NetworkEdge* edge : selectedEdges) {
+        if (incidentEdges.contains(edge)) continue;
+        const int src = edge->sourceNode()->nodeFrontId;
+        const int dst = edge->destNode()->nodeFrontId;
+        deleteEdge(edge);
+        if (graphPanel) graphPanel->removeEdgeRow(src, dst);
+        touchedFronts.insert(src);
+        touchedFronts.insert(dst);
+    }
+
+    // edges of deleted nodes only leave the scene, the backend drops them with the nodes
+    for (NetworkEdge* edge : incidentEdges) {
+        const int src = edge->sourceNode()->nodeFrontId;
+        const int dst = edge->destNode()->nodeFrontId;
+        takeEdgeItem(edge);
+        if (graphPanel) graphPanel->removeEdgeRow(src, dst);
+        touchedFronts.insert(src);
+        touchedFronts.insert(dst);
+        scene->removeItem(edge);
+        delete edge;
     }
 
-    // Second delete any explicitly selected edges not already deleted by deleteNode
-    for (const QPair<int,int>& key : edgeKeysToDelete) {
-        if (edgeItems.contains(key)) {
-            deleteEdge(edgeItems.value(key));
-            if (graphPanel) {
-                graphPanel->removeEdgeRow(key.first, key.second);
-                graphPanel->updateNodeRow(key.first);
-                graphPanel->updateNodeRow(key.second);
-            }
+    for (NetworkNode* node : selectedNodes) {
+        const int frontId = node->nodeFrontId;
+        if (node->isContracted()) {
+            for (int backId : m_frontIds.members(frontId))
+                m_frontIds.resetFront(backId);
+            m_frontIds.removeMembers(frontId);
         }
+        nodeItems.remove(frontId);
+        if (graphPanel) graphPanel->removeNodeRow(frontId);
+        scene->removeItem(node);
+        delete node;
     }
 
-    lastSelectedItems.clear();
-    
+    // one linear pass over the edge array for all of them
+    dataHandler->removeNodes(deletedBackIds);
+
+    // surviving neighbours lost edges, their degrees change
+    if (graphPanel) {
+        for (int frontId : touchedFronts)
+            if (!deletedFronts.contains(frontId)) graphPanel->updateNodeRow(frontId);
+        graphPanel->endBatch();
+    }
+    scene->blockSignals(false);
+
     ui->statusbar->showMessage(QString("Deleted %1 item(s)").arg(selectedItems.size()));
 }
 
@@ -1758,6 +2092,12 @@ void NetSim::handleZoom(QWheelEvent* event) {
 
     ui->graphicsView->scale(scaleFactor, scaleFactor);
     event->accept();
+    scheduleSemanticZoom();
+}
+
+// current view scale, 1 is one scene unit per screen pixel
+qreal NetSim::viewZoom() const {
+    return ui->graphicsView->transform().m11();
 }
 
 // view Settings pop-up
@@ -1825,6 +2165,26 @@ void NetSim::onViewSettings() {
 
     layout->addWidget(layoutGroupBox);
 
+    // semantic zoom, groups open and fold with the zoom level
+    auto* semanticGroupBox = new QGroupBox("Semantic zoom");
+    auto* szLayout = new QFormLayout(semanticGroupBox);
+
+    auto* semanticCb = new QCheckBox("Expand and collapse groups by zoom");
+    semanticCb->setChecked(m_semanticZoom);
+    semanticCb->setToolTip(
+        "Groups the layout into nested grid cells. Zooming in expands the groups in view, zooming out folds them.");
+
+    auto* budgetSpin = new QSpinBox;
+    budgetSpin->setRange(100, 100000);
+    budgetSpin->setSingleStep(100);
+    budgetSpin->setValue(m_semanticBudget);
+    budgetSpin->setToolTip("Most nodes drawn at once, expansion stops here. Edges between them are not counted.");
+
+    szLayout->addRow(semanticCb);
+    szLayout->addRow("Node budget:", budgetSpin);
+
+    layout->addWidget(semanticGroupBox);
+
 
     layout->addWidget(edgeLabelsCb);
     layout->addWidget(gpuCb);
@@ -1875,6 +2235,17 @@ void NetSim::onViewSettings() {
 
         m_defaultLayoutAlgo = algoCombo->currentData().toString();
 
+        // semantic zoom, turning it on groups the current layout. it stays off
+        // if the layout is too small to group
+        m_semanticBudget = budgetSpin->value();
+        if (!semanticCb->isChecked()) {
+            m_semanticZoom = false;
+        } else if (!m_semanticZoom) {
+            buildSemanticPyramid();
+            m_semanticZoom = !m_groupCell.isEmpty();
+        }
+        scheduleSemanticZoom();
+
         scene->update();
         dlg.accept(); 
     });
@@ -1890,6 +2261,7 @@ void NetSim::onZoomIn() {
     if (ui->graphicsView->transform().m11() < maxZoom)
         ui->graphicsView->scale(1.2, 1.2);
     ui->statusbar->showMessage("Zoomed in");
+    scheduleSemanticZoom();
 }
 
 // zoom out of the scene
@@ -1898,6 +2270,7 @@ void NetSim::onZoomOut() {
     if (ui->graphicsView->transform().m11() > minZoom)
         ui->graphicsView->scale(1/1.2, 1/1.2);
     ui->statusbar->showMessage("Zoomed out");
+    scheduleSemanticZoom();
 }
 
 // reset view be around all items in the scene
@@ -1920,6 +2293,7 @@ void NetSim::onResetView() {
     nodeBounds.adjust(-100, -100, 100, 100); 
     ui->graphicsView->resetTransform();
     ui->graphicsView->fitInView(nodeBounds, Qt::KeepAspectRatio);
+    scheduleSemanticZoom();
 }
 
 // when the selected item moves, node or edge
@@ -1946,28 +2320,11 @@ void NetSim::onSelectionChanged() {
             continue;
 
         if (NetworkNode* node = dynamic_cast<NetworkNode*>(item)) {
-            // For contracted nodes (negative ID), skip edge reset – they have no backend edges
-            if (node->nodeFrontId < 0) {
-                item->setZValue(NetworkNode::DEFAULT_ZVALUE);
-                continue;
-            }
-
-            // Verify the node is still present in our map (it might have been removed)
-            if (!nodeItems.contains(node->nodeFrontId)) {
-                item->setZValue(NetworkNode::DEFAULT_ZVALUE);
-                continue;
-            }
-
             item->setZValue(NetworkNode::DEFAULT_ZVALUE);
 
-            const QVector<EdgeInfo> incidentEdges = dataHandler->getEdgesOf(node->nodeFrontId);
-            for (const EdgeInfo& e : incidentEdges) {
-                NetworkEdge* edge = edgeItems.value(qMakePair(node->nodeFrontId, e.destination));
-                if (!edge && !directedEdges) {
-                    edge = edgeItems.value(qMakePair(e.destination, node->nodeFrontId));
-                }
-                if (edge) edge->setZValue(NetworkEdge::DEFAULT_ZVALUE);
-            }
+            // the node's own edge list covers incoming and contracted edges too
+            for (NetworkEdge* edge : node->edges())
+                edge->setZValue(NetworkEdge::DEFAULT_ZVALUE);
         }
         else if (NetworkEdge* edge = dynamic_cast<NetworkEdge*>(item)) {
             item->setZValue(NetworkEdge::DEFAULT_ZVALUE);
@@ -1986,19 +2343,9 @@ void NetSim::onSelectionChanged() {
         if (NetworkNode* node = dynamic_cast<NetworkNode*>(item)) {
             item->setZValue(NetworkNode::SELECTED_ZVALUE);
 
-            if (node->nodeFrontId < 0) continue;
-            if (!nodeItems.contains(node->nodeFrontId)) continue;
-
-            const QVector<EdgeInfo> incidentEdges = dataHandler->getEdgesOf(node->nodeFrontId);
-
             // for all its incident edges, set the z value of the visual edge to selected
-            for (const EdgeInfo& e : incidentEdges) {
-                NetworkEdge* edge = edgeItems.value(qMakePair(node->nodeFrontId, e.destination));
-                if (!edge && !directedEdges) {
-                    edge = edgeItems.value(qMakePair(e.destination, node->nodeFrontId));
-                }
-                if (edge) edge->setZValue(NetworkEdge::SELECTED_ZVALUE);
-            }
+            for (NetworkEdge* edge : node->edges())
+                edge->setZValue(NetworkEdge::SELECTED_ZVALUE);
         } 
         // if we select an edge
         else if (NetworkEdge* edge = dynamic_cast<NetworkEdge*>(item)) {
@@ -0,0 +1,414 @@
+#include "quotientgraph.h"
+#include "datahandler.h"
+#include <algorithm>
+
+// ---------------------------------------------------------------
+// Tree edits
+// ---------------------------------------------------------------
+
+int QuotientGraph::group(const QVector<int>& frontIds)
+{
+    QVector<int> members;
+    QSet<int> memberSet;
+    for (int id : frontIds) {
+        if (!isFront(id) || memberSet.contains(id)) continue;
+        memberSet.insert(id);
+        members.append(id);
+    }
+    if (members.size() < 2) return NoGroup;
+
+    // nest under the shared parent, mixed parents go to the top level
+    int parent = parentOf(members[0]);
+    for (int id : members)
+        if (parentOf(id) != parent) { parent = NoGroup; break; }
+
+    // reuse a pruned slot so contract / expand cycles don't grow the table
+    int id;
+    if (!m_freeGroups.isEmpty()) {
+        id = m_freeGroups.takeLast();
+    } else {
+        id = -(m_groups.size() + 1);
+        m_groups.append(Group());
+    }
+    grp(id).alive = true;
+    grp(id).onFront = true;
+    grp(id).children = members;
+
+    // take the members out of their old parents, each touched child list is filtered once
+    QSet<int> oldParents;
+    for (int m : members) {
+        const int old = parentOf(m);
+        if (old != NoGroup) {
+            oldParents.insert(old);
+            adjustLeafCount(old, -leafCount(m));
+        }
+        grp(id).leafCount += leafCount(m);
+        setParent(m, id);
+    }
+    for (int old : oldParents) {
+        QVector<int>& list = grp(old).children;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&](int c) { return memberSet.contains(c); }), list.end());
+    }
+
+    grp(id).parent = parent;
+    if (parent != NoGroup) {
+        grp(parent).children.append(id);
+        adjustLeafCount(parent, grp(id).leafCount);
+    }
+    for (int old : oldParents) prune(old);
+
+    absorb(id, members, memberSet);
+    return id;
+}
+
+bool QuotientGraph::expand(int groupId)
+{
+    if (!isGroup(groupId) || !grp(groupId).onFront) return false;
+
+    // the group leaves the front, so do its entries in the neighbouring groups
+    Group& g = grp(groupId);
+    for (auto it = g.out.cbegin(); it != g.out.cend(); ++it)
+        if (it.key() < 0) grp(it.key()).in.remove(groupId);
+    for (auto it = g.in.cbegin(); it != g.in.cend(); ++it)
+        if (it.key() < 0) grp(it.key()).out.remove(groupId);
+    g.out.clear();
+    g.in.clear();
+    g.onFront = false;
+    g.expanded = true;
+
+    const QVector<int> kids = g.children;
+    for (int c : kids) {
+        if (c < 0) grp(c).onFront = true;
+        for (int leaf : leaves(c)) m_front[leaf] = c;
+    }
+
+    // recount the arcs of each child. a sibling group fills its own side,
+    // any other front group has its entry for the child added here
+    auto outside = [&](int f) { return f < 0 && grp(f).parent != groupId; };
+    for (int c : kids) {
+        for (int leaf : leaves(c)) {
+            for (const EdgeInfo& e : m_data->getEdgesOf(leaf)) {
+                if (!m_data->nodeExists(e.destination)) continue;
+                const int f = m_front[e.destination];
+                if (f == c) continue;
+                if (c < 0) grp(c).out[f]++;
+                if (outside(f)) grp(f).in[c]++;
+            }
+            for (int src : m_sources[leaf]) {
+                const int f = m_front[src];
+                if (f == c) continue;
+                if (c < 0) grp(c).in[f]++;
+                if (outside(f)) grp(f).out[c]++;
+            }
+        }
+    }
+    return true;
+}
+
+bool QuotientGraph::collapse(int groupId)
+{
+    if (!isGroup(groupId) || !grp(groupId).expanded) return false;
+    for (int p = grp(groupId).parent; p != NoGroup; p = grp(p).parent)
+        if (!grp(p).expanded) return false;
+
+    // drawn descendants, expanded ones in between fold up as well
+    QVector<int> members;
+    QVector<int> stack = grp(groupId).children;
+    while (!stack.isEmpty()) {
+        const int c = stack.takeLast();
+        if (c >= 0 || grp(c).onFront) {
+            members.append(c);
+        } else {
+            grp(c).expanded = false;
+            stack.append(grp(c).children);
+        }
+    }
+
+    grp(groupId).expanded = false;
+    grp(groupId).onFront = true;
+    const QSet<int> memberSet(members.cbegin(), members.cend());
+    absorb(groupId, members, memberSet);
+    return true;
+}
+
+void QuotientGraph::flatten()
+{
+    m_groups.clear();
+    m_freeGroups.clear();
+    m_leafParent.fill(NoGroup);
+    for (int i = 0; i < m_front.size(); ++i) m_front[i] = i;
+}
+
+// ---------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------
+
+bool QuotientGraph::isFront(int id) const
+{
+    if (id < 0) return isGroup(id) && grp(id).onFront;
+    return m_data->nodeExists(id) && frontOf(id) == id;
+}
+
+int QuotientGraph::parentOf(int id) const
+{
+    if (id < 0) return isGroup(id) ? grp(id).parent : NoGroup;
+    return m_leafParent.value(id, NoGroup);
+}
+
+int QuotientGraph::leafCount(int id) const
+{
+    if (id < 0) return isGroup(id) ? grp(id).leafCount : 0;
+    return 1;
+}
+
+int QuotientGraph::depth(int id) const
+{
+    int d = 0;
+    for (int p = parentOf(id); p != NoGroup; p = grp(p).parent) ++d;
+    return d;
+}
+
+QVector<int> QuotientGraph::children(int groupId) const
+{
+    return isGroup(groupId) ? grp(groupId).children : QVector<int>();
+}
+
+QVector<int> QuotientGraph::leaves(int groupId) const
+{
+    if (groupId >= 0) return { groupId };
+
+    QVector<int> out;
+    if (!isGroup(groupId)) return out;
+    out.reserve(grp(groupId).leafCount);
+
+    QVector<int> stack = { groupId };
+    while (!stack.isEmpty()) {
+        const int g = stack.takeLast();
+        for (int c : grp(g).children) {
+            if (c >= 0) out.append(c);
+            else stack.append(c);
+        }
+    }
+    return out;
+}
+
+int QuotientGraph::groupCount() const
+{
+    int count = 0;
+    for (const Group& g : m_groups)
+        if (g.alive) ++count;
+    return count;
+}
+
+QHash<int,int> QuotientGraph::outArcs(int frontId) const
+{
+    if (frontId < 0) return isGroup(frontId) ? grp(frontId).out : QHash<int,int>();
+
+    QHash<int,int> out;
+    for (const EdgeInfo& e : m_data->getEdgesOf(frontId)) {
+        if (!m_data->nodeExists(e.destination)) continue;
+        const int f = frontOf(e.destination);
+        if (f != frontId) out[f]++;
+    }
+    return out;
+}
+
+QHash<int,int> QuotientGraph::inArcs(int frontId) const
+{
+    if (frontId < 0) return isGroup(frontId) ? grp(frontId).in : QHash<int,int>();
+
+    QHash<int,int> in;
+    for (int src : m_sources.value(frontId)) {
+        const int f = frontOf(src);
+        if (f != frontId) in[f]++;
+    }
+    return in;
+}
+
+// ---------------------------------------------------------------
+// Backend hooks
+// ---------------------------------------------------------------
+
+void QuotientGraph::nodeAdded(int backId)
+{
+    // ids grow one at a time when loading, append keeps that amortised
+    while (m_front.size() <= backId) {
+        m_leafParent.append(NoGroup);
+        m_front.append(m_front.size());
+        m_sources.append(QVector<int>());
+    }
+    m_leafParent[backId] = NoGroup;
+    m_front[backId] = backId;
+    m_sources[backId].clear();
+}
+
+// the node's arcs are already gone, only the tree needs fixing
+void QuotientGraph::nodeRemoved(int backId)
+{
+    if (backId < 0 || backId >= m_front.size()) return;
+
+    const int parent = m_leafParent[backId];
+    if (parent != NoGroup) {
+        grp(parent).children.removeOne(backId);
+        adjustLeafCount(parent, -1);
+        prune(parent);
+    }
+    m_leafParent[backId] = NoGroup;
+    m_front[backId] = backId;
+    m_sources[backId].clear();
+}
+
+void QuotientGraph::arcAdded(int src, int dst)
+{
+    if (dst < 0 || dst >= m_sources.size()) return;
+    m_sources[dst].append(src);
+    countArc(frontOf(src), frontOf(dst), 1);
+}
+
+void QuotientGraph::arcRemoved(int src, int dst)
+{
+    if (dst < 0 || dst >= m_sources.size()) return;
+    if (!m_sources[dst].removeOne(src)) return;
+    countArc(frontOf(src), frontOf(dst), -1);
+}
+
+// arcs that were all present, grouped per target so each reverse list is filtered once
+void QuotientGraph::arcsRemoved(const QVector<QPair<int,int>>& arcs)
+{
+    QHash<int, QSet<int>> gone;
+    for (const QPair<int,int>& a : arcs) {
+        if (a.second < 0 || a.second >= m_sources.size()) continue;
+        countArc(frontOf(a.first), frontOf(a.second), -1);
+        gone[a.second].insert(a.first);
+    }
+    for (auto it = gone.cbegin(); it != gone.cend(); ++it) {
+        QVector<int>& list = m_sources[it.key()];
+        const QSet<int>& srcs = it.value();
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&](int src) { return srcs.contains(src); }), list.end());
+    }
+}
+
+// nodes whose arcs are already gone, parents drop them in one filter each
+void QuotientGraph::nodesRemoved(const QVector<int>& backIds)
+{
+    QSet<int> dead;
+    QSet<int> parents;
+    for (int id : backIds) {
+        if (id < 0 || id >= m_front.size() || dead.contains(id)) continue;
+        dead.insert(id);
+
+        const int parent = m_leafParent[id];
+        if (parent != NoGroup) {
+            parents.insert(parent);
+            adjustLeafCount(parent, -1);
+        }
+        m_leafParent[id] = NoGroup;
+        m_front[id] = id;
+        m_sources[id].clear();
+    }
+
+    for (int p : parents) {
+        QVector<int>& list = grp(p).children;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&](int c) { return dead.contains(c); }), list.end());
+    }
+    for (int p : parents)
+        if (isGroup(p)) prune(p);
+}
+
+void QuotientGraph::clear()
+{
+    m_groups.clear();
+    m_freeGroups.clear();
+    m_leafParent.clear();
+    m_front.clear();
+    m_sources.clear();
+}
+
+// ---------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------
+
+void QuotientGraph::setParent(int id, int parent)
+{
+    if (id < 0) grp(id).parent = parent;
+    else m_leafParent[id] = parent;
+}
+
+void QuotientGraph::adjustLeafCount(int groupId, int delta)
+{
+    for (int g = groupId; g != NoGroup; g = grp(g).parent)
+        grp(g).leafCount += delta;
+}
+
+// drop groups left without children, walking up while parents empty out too
+void QuotientGraph::prune(int groupId)
+{
+    int g = groupId;
+    while (g != NoGroup && isGroup(g) && grp(g).children.isEmpty()) {
+        const int parent = grp(g).parent;
+        if (parent != NoGroup) grp(parent).children.removeOne(g);
+        grp(g) = Group();
+        m_freeGroups.append(g);
+        g = parent;
+    }
+}
+
+// put a group on the front in place of members, merging their arcs. stored
+// counts of member groups are moved over, leaf members are read from the backend
+void QuotientGraph::absorb(int groupId, const QVector<int>& members, const QSet<int>& memberSet)
+{
+    for (int m : members)
+        for (int leaf : leaves(m)) m_front[leaf] = groupId;
+
+    Group& g = grp(groupId);
+    for (int m : members) {
+        if (m < 0) {
+            Group& c = grp(m);
+            for (auto it = c.out.cbegin(); it != c.out.cend(); ++it) {
+                const int o = it.key();
+                if (memberSet.contains(o)) continue;
+                g.out[o] += it.value();
+                if (o < 0) { grp(o).in.remove(m); grp(o).in[groupId] += it.value(); }
+            }
+            for (auto it = c.in.cbegin(); it != c.in.cend(); ++it) {
+                const int o = it.key();
+                if (memberSet.contains(o)) continue;
+                g.in[o] += it.value();
+                if (o < 0) { grp(o).out.remove(m); grp(o).out[groupId] += it.value(); }
+            }
+            c.out.clear();
+            c.in.clear();
+            c.onFront = false;
+        } else {
+            for (const EdgeInfo& e : m_data->getEdgesOf(m)) {
+                if (!m_data->nodeExists(e.destination)) continue;
+                const int f = m_front[e.destination];
+                if (f == groupId) continue;
+                g.out[f]++;
+                if (f < 0) { grp(f).in.remove(m); grp(f).in[groupId]++; }
+            }
+            for (int src : m_sources[m]) {
+                const int f = m_front[src];
+                if (f == groupId) continue;
+                g.in[f]++;
+                if (f < 0) { grp(f).out.remove(m); grp(f).out[groupId]++; }
+            }
+        }
+    }
+}
+
+void QuotientGraph::countArc(int fromFront, int toFront, int delta)
+{
+    if (fromFront == toFront) return;
+
+    auto bump = [delta](QHash<int,int>& counts, int key) {
+        const int value = counts.value(key) + delta;
+        if (value > 0) counts[key] = value;
+        else counts.remove(key);
+    };
+    if (fromFront < 0) bump(grp(fromFront).out, toFront);
+    if (toFront < 0) bump(grp(toFront).in, fromFront);
+}
@@ -0,0 +1,92 @@
+#ifndef QUOTIENTGRAPH_H
+#define QUOTIENTGRAPH_H
+
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+
+class DataHandler;
+
+// ---------------------------------------------------------------
+// QuotientGraph
+// ---------------------------------------------------------------
+
+// tree of contraction groups over the backend nodes. leaves are backend ids (>= 0)
+// and groups take negative ids, so a drawn node's id is its front id. a group is
+// either collapsed (drawn as one node) or expanded (its children are drawn), the
+// drawn nodes are the front. arc counts between a front group and its neighbours
+// are stored on the group and follow every backend edit, so grouping, expanding
+// and collapsing only touch the members and the arcs incident to them
+class QuotientGraph {
+public:
+    static constexpr int NoGroup = 0;   // parent of top level nodes, group ids are all negative
+
+    explicit QuotientGraph(const DataHandler* data) : m_data(data) {}
+
+    // new collapsed group over front nodes, placed under their common parent or at the
+    // top level if they differ. returns the group id, NoGroup if under 2 front nodes given.
+    // ids of groups pruned empty are handed out again
+    int group(const QVector<int>& frontIds);
+    bool expand(int groupId);       // draw the children instead of the group
+    bool collapse(int groupId);     // fold every drawn descendant back into the group
+    void flatten();                 // drop every group, all leaves are drawn again
+
+    bool isGroup(int id) const { return id < 0 && -id - 1 < m_groups.size() && m_groups[-id - 1].alive; }
+    bool isFront(int id) const;
+    int frontOf(int backId) const { return m_front.value(backId, backId); }
+    int parentOf(int id) const;
+    int leafCount(int id) const;
+    int depth(int id) const;
+    QVector<int> children(int groupId) const;
+    QVector<int> leaves(int groupId) const;
+    int groupCount() const;
+
+    // arc counts from / to a front node, keyed by the neighbouring front node
+    QHash<int,int> outArcs(int frontId) const;
+    QHash<int,int> inArcs(int frontId) const;
+
+    // nodes with an arc into backId
+    QVector<int> sourcesOf(int backId) const { return m_sources.value(backId); }
+
+    // backend hooks, called by DataHandler on every change
+    void nodeAdded(int backId);
+    void nodeRemoved(int backId);
+    void arcAdded(int src, int dst);
+    void arcRemoved(int src, int dst);
+    void clear();
+
+    // bulk forms for deleting many nodes at once, each touched list is filtered once
+    void arcsRemoved(const QVector<QPair<int,int>>& arcs);
+    void nodesRemoved(const QVector<int>& backIds);
+
+private:
+    struct Group {
+        int parent = NoGroup;
+        QVector<int> children;
+        QHash<int,int> out;     // only filled while the group is on the front
+        QHash<int,int> in;
+        int leafCount = 0;
+        bool expanded = false;
+        bool onFront = false;
+        bool alive = false;
+    };
+
+    const DataHandler* m_data;
+    QVector<Group> m_groups;            // group id g lives at -g - 1, ids only hold until flatten()
+    QVector<int> m_freeGroups;          // ids of pruned groups, handed out again by group()
+    QVector<int> m_leafParent;          // per backend id
+    QVector<int> m_front;               // drawn node each backend id folds into
+    QVector<QVector<int>> m_sources;    // reverse arcs, the backend only stores outgoing ones
+
+    Group& grp(int id) { return m_groups[-id - 1]; }
+    const Group& grp(int id) const { return m_groups[-id - 1]; }
+
+    void setParent(int id, int parent);
+    void adjustLeafCount(int groupId, int delta);
+    void prune(int groupId);
+    void absorb(int groupId, const QVector<int>& members, const QSet<int>& memberSet);
+    void countArc(int fromFront, int toFront, int delta);
+};
+
+#endif // QUOTIENTGRAPH_H